@@ -0,0 +1,126 @@
+/**
+ * arena.c - per-line memory that is released all at once.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./Output.h"
+#include "./Arena.h"
+
+#define ALIGN 8 // every allocation starts at a multiple of this
+
+
+/**
+ * Sets up an arena without any blocks.
+ *
+ * @param arena the arena
+ */
+void arena_init(arena_t *arena) {
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->used = 0;
+    arena->last = NULL;
+}
+
+/**
+ * Releases everything allocated since the last reset, keeping the blocks.
+ *
+ * @param arena the arena
+ */
+void arena_reset(arena_t *arena) {
+    arena->current = arena->first;
+    arena->used = 0;
+    arena->last = NULL;
+}
+
+/**
+ * Frees every block.
+ *
+ * @param arena the arena
+ */
+void arena_free(arena_t *arena) {
+    arena_block_t *block = arena->first;
+
+    while (block != NULL) {
+        arena_block_t *next = block->next;
+
+        free(block);
+        block = next;
+    }
+    arena_init(arena);
+}
+
+/**
+ * @param block a block
+ * @return its first byte
+ */
+static char *block_data(arena_block_t *block) {
+    return (char *) (block + 1);
+}
+
+/**
+ * Hands out memory from the current block, moving on to the next block
+ * that is big enough, or to a new one after the current block.
+ *
+ * @param arena the arena
+ * @param size the number of bytes
+ * @return the memory, valid until the next reset
+ */
+void *arena_alloc(arena_t *arena, size_t size) {
+    arena_block_t *block;
+
+    size = (size + ALIGN - 1) / ALIGN * ALIGN;
+    if (arena->current == NULL || size > arena->current->size - arena->used) {
+        block = arena->current ? arena->current->next : arena->first;
+        if (block == NULL || size > block->size) {
+            size_t block_size = size > ARENA_BLOCK ? size : ARENA_BLOCK;
+
+            block = malloc(sizeof(arena_block_t) + block_size);
+            if (block == NULL) {
+                out_of_memory("ERROR: out of memory for the line arena");
+            }
+            block->size = block_size;
+            if (arena->current == NULL) {
+                block->next = arena->first;
+                arena->first = block;
+            } else {
+                block->next = arena->current->next;
+                arena->current->next = block;
+            }
+        }
+        arena->current = block;
+        arena->used = 0;
+    }
+    arena->last = block_data(arena->current) + arena->used;
+    arena->used += size;
+    return arena->last;
+}
+
+/**
+ * Makes an allocation bigger, in place when it is the last one and its
+ * block has room, otherwise by copying it to a new allocation.
+ *
+ * @param arena the arena
+ * @param allocation the allocation
+ * @param size its size
+ * @param new_size the size it needs
+ * @return the allocation, which may have moved
+ */
+void *arena_grow(arena_t *arena, void *allocation, size_t size, size_t new_size) {
+    void *grown;
+
+    size = (size + ALIGN - 1) / ALIGN * ALIGN;
+    new_size = (new_size + ALIGN - 1) / ALIGN * ALIGN;
+    if (allocation == arena->last
+        && new_size - size <= arena->current->size - arena->used) {
+        arena->used += new_size - size;
+        return allocation;
+    }
+    grown = arena_alloc(arena, new_size);
+    memcpy(grown, allocation, size);
+    return grown;
+}
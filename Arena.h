@@ -0,0 +1,38 @@
+#ifndef ARENA_H
+   #define ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_BLOCK 4096 // bytes in a block, unless one allocation needs more
+
+/* a block of an arena, its bytes follow it */
+typedef struct arena_block {
+    struct arena_block *next;
+    size_t size;
+} arena_block_t;
+
+/*
+ * Memory for what only lives as long as one line. Allocations are handed
+ * out from the blocks in order and never freed one by one: a reset starts
+ * over at the first block and keeps every block for the next line, so a
+ * line that needs no more than an earlier one makes no heap calls.
+ */
+typedef struct arena {
+    arena_block_t *first;
+    arena_block_t *current;
+    size_t used;           // bytes handed out from the current block
+    void *last;            // the last allocation, which can grow in place
+} arena_t;
+
+/*
+ * Purpose: Function Prototypes for arena.c
+ * Date:    October 17, 2026
+ */
+void arena_init(arena_t *arena);
+void arena_reset(arena_t *arena);
+void arena_free(arena_t *arena);
+void *arena_alloc(arena_t *arena, size_t size);
+void *arena_grow(arena_t *arena, void *allocation, size_t size, size_t new_size);
+
+
+#endif
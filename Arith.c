@@ -0,0 +1,354 @@
+/*
+ * arith.c - evaluates a tree from ast.c with wider values than int.
+ * ast_eval_checked works in 64 bits and stops at the first overflow
+ * instead of wrapping around. ast_eval_big never overflows, it uses the
+ * numbers of big.c. Both read each literal again from its digits, so
+ * literals too big for an int keep their value, and both compute ^ on
+ * integers by squaring instead of with pow() on doubles.
+ * Date:   October 17, 2026
+ */
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <limits.h>
+
+#include "Tokenizer.h"
+
+#include "Output.h"
+
+#include "Context.h"
+
+#include "Parser.h"
+
+#include "Ast.h"
+
+#include "Big.h"
+
+#include "Arith.h"
+
+#include "Symbols.h"
+
+
+/**
+ * Sets up an empty set of registers
+ * @param registers the registers
+ */
+void registers_init(registers_t * registers) {
+   registers->values = NULL;
+   registers->capacity = 0;
+   registers->variables = NULL;
+   registers->variable_capacity = 0;
+}
+
+/**
+ * Releases the registers, those of the variables, and the limbs of every
+ * number in them
+ * @param registers the registers
+ */
+void registers_free(registers_t * registers) {
+   int i;
+
+   for (i = 0; i < registers->capacity; i++)
+      big_free(&registers->values[i]);
+   for (i = 0; i < registers->variable_capacity; i++)
+      big_free(&registers->variables[i]);
+   free(registers->values);
+   free(registers->variables);
+   registers_init(registers);
+}
+
+/**
+ * Reads the value of a NUM_NODE in 64 bits
+ * @param ast the arena holding the tree
+ * @param node the NUM_NODE
+ * @param value where the value is stored
+ * @return ARITH_OK or ARITH_OVERFLOW
+ */
+static int checked_literal(ast_t * ast, node_t * node, long long * value) {
+   const char *digits;
+   long long total = 0;
+   int i;
+
+   //not a literal, only the int it stands for
+   if (node->left == NO_NODE) {
+      *value = node->value;
+      return ARITH_OK;
+   }
+
+   digits = ast->line + node->left;
+   for (i = 0; i < node->right; i++) {
+      int digit = digits[i] - '0';
+
+      if (total > (LLONG_MAX - digit) / 10)
+         return ARITH_OVERFLOW;
+      total = total * 10 + digit;
+   }
+   *value = total;
+   return ARITH_OK;
+}
+
+/**
+ * Raises a number to a power by squaring. A negative exponent gives the
+ * integer part of 1 / base^-exponent, which is 0 unless base is 1 or -1.
+ * @param base the base
+ * @param exponent the exponent
+ * @param value where the power is stored
+ * @return ARITH_OK, ARITH_OVERFLOW or ARITH_DIVIDE_BY_ZERO
+ */
+int checked_pow(long long base, long long exponent, long long * value) {
+   long long result = 1;
+
+   if (exponent < 0) {
+      if (base == 0)
+         return ARITH_DIVIDE_BY_ZERO;
+      if (base == 1 || base == -1)
+         *value = base == -1 && (exponent & 1) ? -1 : 1;
+      else
+         *value = 0;
+      return ARITH_OK;
+   }
+
+   while (exponent > 0) {
+      if ((exponent & 1) && mul_overflows(result, base, &result))
+         return ARITH_OVERFLOW;
+      exponent >>= 1;
+      //the square is only needed while bits of the exponent remain
+      if (exponent > 0 && mul_overflows(base, base, &base))
+         return ARITH_OVERFLOW;
+   }
+   *value = result;
+   return ARITH_OK;
+}
+
+/**
+ * Works out the value of one node in 64 bits from those of its operands
+ * @param ast the arena holding the node
+ * @param node the node
+ * @param left the value of its left operand, unused for a NUM_NODE or VARIABLE_NODE
+ * @param right the value of its right operand, unused without one
+ * @param value where the value of the node is stored
+ * @return ARITH_OK, or the error it found
+ */
+int checked_apply(ast_t * ast, node_t * node, long long left, long long right, long long * value) {
+   switch (node->kind) {
+   case NUM_NODE:
+      return checked_literal(ast, node, value);
+   case VARIABLE_NODE:
+      *value = ast->symbols->wide[node->value];
+      return ARITH_OK;
+   case ADD_NODE:
+      return add_overflows(left, right, value) ? ARITH_OVERFLOW : ARITH_OK;
+   case SUB_NODE:
+      return sub_overflows(left, right, value) ? ARITH_OVERFLOW : ARITH_OK;
+   case MULT_NODE:
+      return mul_overflows(left, right, value) ? ARITH_OVERFLOW : ARITH_OK;
+   case DIV_NODE:
+      if (right == 0)
+         return ARITH_DIVIDE_BY_ZERO;
+      if (left == LLONG_MIN && right == -1)
+         return ARITH_OVERFLOW;
+      *value = left / right;
+      return ARITH_OK;
+   case EXPON_NODE:
+      return checked_pow(left, right, value);
+   case LESS_THEN_NODE:
+      *value = left < right;
+      return ARITH_OK;
+   case LESS_THEN_OR_EQUAL_NODE:
+      *value = left <= right;
+      return ARITH_OK;
+   case GREATER_THEN_NODE:
+      *value = left > right;
+      return ARITH_OK;
+   case GREATER_THEN_OR_EQUAL_NODE:
+      *value = left >= right;
+      return ARITH_OK;
+   case EQUALS_NODE:
+      *value = left == right;
+      return ARITH_OK;
+   case NOT_EQUALS_NODE:
+      *value = left != right;
+      return ARITH_OK;
+   default:
+      *value = node->value;
+      return ARITH_OK;
+   }
+}
+
+/**
+ * Evaluates the tree below a node in 64 bits
+ * @param ast the arena holding the tree
+ * @param root the node to evaluate
+ * @param value where the value of the node is stored
+ * @return ARITH_OK, or the first error found
+ */
+int ast_eval_checked(ast_t * ast, int root, long long * value) {
+   int count = ast_order(ast, root);
+   long long *top = ast->operands; // above the values of the nodes not yet used as operands
+   int i;
+
+   for (i = 0; i < count; i++) {
+      node_t *node = &ast->nodes[ast->order[i]];
+      long long left = 0;
+      long long right = 0;
+      int status;
+
+      if (node->kind != NUM_NODE && node->kind != VARIABLE_NODE) {
+         if (node->right != NO_NODE)
+            right = *--top;
+         left = *--top;
+      }
+      status = checked_apply(ast, node, left, right, top);
+      if (status != ARITH_OK)
+         return status;
+      top++;
+   }
+   *value = ast->operands[0];
+   return ARITH_OK;
+}
+
+/**
+ * Evaluates one node into its register from the registers of its
+ * operands. Every node has a register of its own, so no operation has
+ * its result as an operand and the limbs are reused from statement to
+ * statement.
+ * @param registers a register for each node of the tree
+ * @param ast the arena holding the tree
+ * @param index the node to evaluate
+ * @return ARITH_OK, or the error it found
+ */
+static int big_node(registers_t * registers, ast_t * ast, int index) {
+   node_t *node = &ast->nodes[index];
+   big_t *value = &registers->values[index];
+   big_t *left;
+   big_t *right;
+
+   if (node->kind == NUM_NODE) {
+      if (node->left == NO_NODE)
+         big_set(value, node->value);
+      else
+         big_digits(value, ast->line + node->left, node->right);
+      return ARITH_OK;
+   }
+   if (node->kind == VARIABLE_NODE) {
+      big_copy(value, &registers->variables[node->value]);
+      return ARITH_OK;
+   }
+
+   left = &registers->values[node->left];
+   right = &registers->values[node->right];
+
+   switch (node->kind) {
+   case ADD_NODE:
+      return big_add(value, left, right);
+   case SUB_NODE:
+      return big_sub(value, left, right);
+   case MULT_NODE:
+      return big_mul(value, left, right);
+   case DIV_NODE:
+      return big_div(value, left, right);
+   case EXPON_NODE:
+      return big_pow(value, left, right);
+   case LESS_THEN_NODE:
+      big_set(value, big_compare(left, right) < 0);
+      return ARITH_OK;
+   case LESS_THEN_OR_EQUAL_NODE:
+      big_set(value, big_compare(left, right) <= 0);
+      return ARITH_OK;
+   case GREATER_THEN_NODE:
+      big_set(value, big_compare(left, right) > 0);
+      return ARITH_OK;
+   case GREATER_THEN_OR_EQUAL_NODE:
+      big_set(value, big_compare(left, right) >= 0);
+      return ARITH_OK;
+   case EQUALS_NODE:
+      big_set(value, big_compare(left, right) == 0);
+      return ARITH_OK;
+   case NOT_EQUALS_NODE:
+      big_set(value, big_compare(left, right) != 0);
+      return ARITH_OK;
+   default:
+      big_set(value, node->value);
+      return ARITH_OK;
+   }
+}
+
+/**
+ * Evaluates a tree with numbers of any size
+ * @param registers a register for each node, grown to fit the tree
+ * @param ast the arena holding the tree
+ * @param root the node to evaluate
+ * @return ARITH_OK with the value in registers->values[root], or the
+ * first error found
+ */
+int ast_eval_big(registers_t * registers, ast_t * ast, int root) {
+   int count;
+   int i;
+
+   if (ast->count > registers->capacity) {
+      int capacity = registers->capacity ? registers->capacity : 64;
+      big_t *values;
+
+      while (capacity < ast->count)
+         capacity *= 2;
+      values = realloc(registers->values, capacity * sizeof(big_t));
+      if (values == NULL)
+         out_of_memory("ERROR: out of memory for big registers");
+      registers->values = values;
+      for (i = registers->capacity; i < capacity; i++)
+         big_init(&registers->values[i]);
+      registers->capacity = capacity;
+   }
+   count = ast_order(ast, root);
+   for (i = 0; i < count; i++) {
+      int status = big_node(registers, ast, ast->order[i]);
+
+      if (status != ARITH_OK)
+         return status;
+   }
+   return ARITH_OK;
+}
+
+/**
+ * Keeps the value a statement evaluated with ast_eval_big had as the
+ * value of a variable
+ * @param registers the registers the statement was evaluated in
+ * @param slot the slot of the variable
+ * @param root the root of the statement, whose register holds its value
+ */
+void big_assign(registers_t * registers, int slot, int root) {
+   if (slot >= registers->variable_capacity) {
+      int capacity = registers->variable_capacity ? registers->variable_capacity : 16;
+      big_t *variables;
+      int i;
+
+      while (capacity <= slot)
+         capacity *= 2;
+      variables = realloc(registers->variables, capacity * sizeof(big_t));
+      if (variables == NULL)
+         out_of_memory("ERROR: out of memory for big registers");
+      registers->variables = variables;
+      for (i = registers->variable_capacity; i < capacity; i++)
+         big_init(&registers->variables[i]);
+      registers->variable_capacity = capacity;
+   }
+   big_copy(&registers->variables[slot], &registers->values[root]);
+}
+
+/**
+ * @param status an error from one of the evaluators
+ * @return the line printed for it
+ */
+const char * arith_message(int status) {
+   switch (status) {
+   case ARITH_OVERFLOW:
+      return "Arithmetic Error: overflow";
+   case ARITH_DIVIDE_BY_ZERO:
+      return "Arithmetic Error: division by zero";
+   case ARITH_TOO_LARGE:
+      return "Arithmetic Error: value too large";
+   default:
+      return "Arithmetic OK";
+   }
+}
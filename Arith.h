@@ -0,0 +1,65 @@
+#ifndef ARITH_H
+   #define ARITH_H
+
+#include <limits.h>
+
+/* 64-bit operations that report overflow instead of wrapping around */
+#ifdef __GNUC__
+#define add_overflows(a, b, r) __builtin_add_overflow(a, b, r)
+#define sub_overflows(a, b, r) __builtin_sub_overflow(a, b, r)
+#define mul_overflows(a, b, r) __builtin_mul_overflow(a, b, r)
+#else
+static inline int add_overflows(long long a, long long b, long long * r) {
+   if ((b > 0 && a > LLONG_MAX - b) || (b < 0 && a < LLONG_MIN - b))
+      return 1;
+   *r = a + b;
+   return 0;
+}
+
+static inline int sub_overflows(long long a, long long b, long long * r) {
+   if ((b < 0 && a > LLONG_MAX + b) || (b > 0 && a < LLONG_MIN + b))
+      return 1;
+   *r = a - b;
+   return 0;
+}
+
+static inline int mul_overflows(long long a, long long b, long long * r) {
+   if (a > 0 ? (b > 0 ? a > LLONG_MAX / b : b < LLONG_MIN / a)
+             : (b > 0 ? a < LLONG_MIN / b : a != 0 && b < LLONG_MAX / a))
+      return 1;
+   *r = a * b;
+   return 0;
+}
+#endif
+
+/* how wide the values of a statement are */
+enum arith {
+   INT_ARITH,     // int, with the same overflow and pow() as parser.c
+   CHECKED_ARITH, // 64 bits, overflow is an error
+   BIG_ARITH      // any size, up to BIG_MAX_LIMBS
+};
+
+/* a big number for every node of a tree, reused from one statement to the
+   next, and one for every variable, which outlives the statement */
+typedef struct registers {
+   big_t *values;
+   int capacity;
+   big_t *variables; // by slot
+   int variable_capacity;
+} registers_t;
+
+/*
+ * Purpose: Function Prototypes for arith.c
+ * Date:    October 17, 2026
+ */
+void registers_init(registers_t *);
+void registers_free(registers_t *);
+int checked_apply(ast_t *, node_t *, long long, long long, long long *);
+int ast_eval_checked(ast_t *, int, long long *);
+int ast_eval_big(registers_t *, ast_t *, int);
+void big_assign(registers_t *, int, int);
+int checked_pow(long long, long long, long long *);
+const char * arith_message(int);
+
+
+#endif
@@ -0,0 +1,488 @@
+/*
+ * ast.c - builds a tree for a statement of the grammar in parser.c so it
+ * can be parsed once and evaluated any number of times.
+ * The parse functions mirror the non-terminals of the grammar and report
+ * the same diagnostics as parser.c, but return node indexes instead of
+ * values. Nodes live in a growable arena and refer to their children by
+ * index, so a whole tree is freed or reset at once. A tree can be as tall
+ * as its line is long, so the walks over it, here and in the evaluators,
+ * compiler and optimizer, go through the list ast_order makes instead of
+ * recursing.
+ * Date:   October 17, 2026
+ */
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <string.h>
+
+#include <math.h>
+
+#include "Tokenizer.h"
+
+#include "Output.h"
+
+#include "Context.h"
+
+#include "Parser.h"
+
+#include "Ast.h"
+
+#include "Big.h"
+
+#include "Symbols.h"
+
+
+/* Node kind of each binary operator token */
+static const enum node_kind operator_nodes[TOKEN_KINDS] = {
+   [ADD_OP] = ADD_NODE,
+   [SUB_OP] = SUB_NODE,
+   [MULT_OP] = MULT_NODE,
+   [DIV_OP] = DIV_NODE,
+   [EXPON_OP] = EXPON_NODE,
+   [LESS_THEN_OP] = LESS_THEN_NODE,
+   [LESS_THEN_OR_EQUAL_OP] = LESS_THEN_OR_EQUAL_NODE,
+   [GREATER_THEN_OP] = GREATER_THEN_NODE,
+   [GREATER_THEN_OR_EQUAL_OP] = GREATER_THEN_OR_EQUAL_NODE,
+   [EQUALS_OP] = EQUALS_NODE,
+   [NOT_EQUALS_OP] = NOT_EQUALS_NODE
+};
+
+
+/**
+ * Sets up an empty arena
+ * @param ast the arena
+ */
+void ast_init(ast_t * ast) {
+   ast->nodes = NULL;
+   ast->count = 0;
+   ast->capacity = 0;
+   ast->line = NULL;
+   ast->symbols = NULL;
+   ast->status = ARITH_OK;
+   ast->order = NULL;
+   ast->operands = NULL;
+   ast->walk_capacity = 0;
+}
+
+/**
+ * Drops every node but keeps the memory for the next statement
+ * @param ast the arena
+ */
+void ast_reset(ast_t * ast) {
+   ast->count = 0;
+}
+
+/**
+ * Releases the memory of the arena
+ * @param ast the arena
+ */
+void ast_free(ast_t * ast) {
+   free(ast->nodes);
+   free(ast->order);
+   free(ast->operands);
+   ast_init(ast);
+}
+
+/**
+ * Appends a node to the arena, growing it when full
+ * @param ast the arena
+ * @param kind the kind of the node
+ * @param left the left operand, the value of a NUM_NODE or the slot of a VARIABLE_NODE
+ * @param right the right operand, unused for a NUM_NODE or VARIABLE_NODE
+ * @return the index of the new node
+ */
+int ast_node(ast_t * ast, enum node_kind kind, int left, int right) {
+   node_t *node;
+
+   if (ast->count == ast->capacity) {
+      int capacity = ast->capacity ? ast->capacity * 2 : 64;
+      node_t *nodes = realloc(ast->nodes, capacity * sizeof(node_t));
+
+      if (nodes == NULL)
+         out_of_memory("ERROR: out of memory for the syntax tree");
+      ast->nodes = nodes;
+      ast->capacity = capacity;
+   }
+
+   node = &ast->nodes[ast->count];
+   node->kind = kind;
+   if (kind == NUM_NODE || kind == VARIABLE_NODE) {
+      node->value = left;
+      node->left = NO_NODE;
+      node->right = NO_NODE;
+   } else {
+      node->value = 0;
+      node->left = left;
+      node->right = right;
+   }
+   return ast->count++;
+}
+
+/**
+ * <bexpr> ::= <name> = <expr> ; | <expr> ;
+ * The tree is of the expression, the slot assigned is left in ctx->target.
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme
+ * @return the root of the statement or NO_NODE
+ */
+int parse_bexpr(context_t * ctx, ast_t * ast, token_t * token) {
+   int root;
+
+   ctx->syntax_error = 0;
+   ast->line = ctx->line;
+   ast->symbols = ctx->symbols;
+   assignment(ctx, token);
+   root = parse_expr(ctx, ast, token);
+
+   //Make sure there is a semicolon
+   if (!statement_end(ctx, token, root != NO_NODE))
+      return NO_NODE;
+   return root;
+}
+
+/**
+ * <expr> -> <term> <ttail>
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme
+ * @return the root of the expression or NO_NODE
+ */
+int parse_expr(context_t * ctx, ast_t * ast, token_t * token) {
+   int left = parse_term(ctx, ast, token);
+
+   if (left == NO_NODE)
+      return left;
+   return parse_ttail(ctx, ast, token, left);
+}
+
+/**
+ * <ttail> -> <add_sub_tok> <term> <ttail> | e
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme
+ * @param left the tree built up to this point
+ * @return the root of the expression or NO_NODE
+ */
+int parse_ttail(context_t * ctx, ast_t * ast, token_t * token, int left) {
+   enum node_kind kind;
+   int right;
+
+   if (token->kind != ADD_OP && token->kind != SUB_OP)
+      return left;
+
+   kind = operator_nodes[token->kind];
+   get_token(ctx, token);
+   right = parse_term(ctx, ast, token);
+   if (right == NO_NODE)
+      return right;
+   return parse_ttail(ctx, ast, token, ast_node(ast, kind, left, right));
+}
+
+/**
+ * <term> -> <stmt> <stail>
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme
+ * @return the root of the term or NO_NODE
+ */
+int parse_term(context_t * ctx, ast_t * ast, token_t * token) {
+   int left = parse_stmt(ctx, ast, token);
+
+   if (left == NO_NODE)
+      return left;
+   return parse_stail(ctx, ast, token, left);
+}
+
+/**
+ * <stail> ::=  <mult_div_tok> <stmt> <stail> | e
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme
+ * @param left the tree built up to this point
+ * @return the root of the term or NO_NODE
+ */
+int parse_stail(context_t * ctx, ast_t * ast, token_t * token, int left) {
+   enum node_kind kind;
+   int right;
+
+   if (token->kind != MULT_OP && token->kind != DIV_OP)
+      return left;
+
+   kind = operator_nodes[token->kind];
+   get_token(ctx, token);
+   right = parse_stmt(ctx, ast, token);
+   if (right == NO_NODE)
+      return right;
+   return parse_stail(ctx, ast, token, ast_node(ast, kind, left, right));
+}
+
+/**
+ * <stmt> -> <factor> <ftail>
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme
+ * @return the root of the statement or NO_NODE
+ */
+int parse_stmt(context_t * ctx, ast_t * ast, token_t * token) {
+   int left = parse_factor(ctx, ast, token);
+
+   if (left == NO_NODE)
+      return left;
+   return parse_ftail(ctx, ast, token, left);
+}
+
+/**
+ * <ftail> ::=  <compare_tok> <factor> <ftail> | e
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme
+ * @param left the tree built up to this point
+ * @return the root of the comparison or NO_NODE
+ */
+int parse_ftail(context_t * ctx, ast_t * ast, token_t * token, int left) {
+   enum node_kind kind;
+   int right;
+
+   switch (token->kind) {
+   case LESS_THEN_OP:
+   case LESS_THEN_OR_EQUAL_OP:
+   case GREATER_THEN_OP:
+   case GREATER_THEN_OR_EQUAL_OP:
+   case EQUALS_OP:
+   case NOT_EQUALS_OP:
+      break;
+   default:
+      return left;
+   }
+
+   kind = operator_nodes[token->kind];
+   get_token(ctx, token);
+   right = parse_factor(ctx, ast, token);
+   if (right == NO_NODE)
+      return right;
+   return parse_ftail(ctx, ast, token, ast_node(ast, kind, left, right));
+}
+
+/**
+ * <factor> ::=  <expp> ^ <factor> | <expp>
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme
+ * @return the root of the factor or NO_NODE
+ */
+int parse_factor(context_t * ctx, ast_t * ast, token_t * token) {
+   int base = parse_expp(ctx, ast, token);
+   int exponent;
+
+   if (token->kind != EXPON_OP)
+      return base;
+
+   if (!get_token(ctx, token) || base == NO_NODE)
+      return NO_NODE;
+
+   exponent = parse_factor(ctx, ast, token);
+   if (exponent == NO_NODE)
+      return NO_NODE;
+   return ast_node(ast, EXPON_NODE, base, exponent);
+}
+
+/**
+ * <expp> ::=  ( <expr> ) | <num> | <name>
+ * Parentheses only group, they do not get a node of their own.
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme
+ * @return the root of the expression or NO_NODE
+ */
+int parse_expp(context_t * ctx, ast_t * ast, token_t * token) {
+   int inner;
+
+   if (token->kind == IDENTIFIER)
+      return parse_name(ctx, ast, token);
+   if (token->kind != LEFT_PAREN)
+      return parse_num(ctx, ast, token);
+
+   if (!get_token(ctx, token))
+      return NO_NODE;
+
+   inner = parse_expr(ctx, ast, token);
+   if (token->kind != RIGHT_PAREN) {
+      //No closing parenthesis error
+      strcpy(ctx->lex_error, ")");
+      ctx->syntax_error = 1;
+      output_string(ctx->out, "===> ')' expected\nSyntax Error\n");
+      ctx->reported = 1;
+      return NO_NODE;
+   }
+   if (!get_token(ctx, token))
+      return NO_NODE;
+   return inner;
+}
+
+/**
+ * <num> ::=  {0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9}+
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme
+ * @return the new NUM_NODE or NO_NODE
+ */
+int parse_num(context_t * ctx, ast_t * ast, token_t * token) {
+   int node;
+
+   if (token->kind != INT_LITERAL)
+      return NO_NODE;
+
+   //keep where the digits are for the 64-bit and big arithmetic modes
+   node = ast_node(ast, NUM_NODE, int_value(token), NO_NODE);
+   ast->nodes[node].left = token->lexeme - ctx->line;
+   ast->nodes[node].right = token->length;
+   if (!get_token(ctx, token))
+      return NO_NODE;
+   return node;
+}
+
+/**
+ * <name> ::=  {a-z | A-Z | _} {a-z | A-Z | _ | 0-9}*
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param token the current lexeme, a name
+ * @return the new VARIABLE_NODE or NO_NODE
+ */
+int parse_name(context_t * ctx, ast_t * ast, token_t * token) {
+   int slot = variable(ctx, token);
+
+   if (slot == NO_SLOT || !get_token(ctx, token))
+      return NO_NODE;
+   return ast_node(ast, VARIABLE_NODE, slot, NO_NODE);
+}
+
+/**
+ * Lists the nodes of the tree below a node in ast->order, each one after
+ * its operands and a left operand before a right one: the order in which
+ * recursion would finish with them. The list is made backwards, parents
+ * before their right then their left operands, from the end of the array
+ * while the nodes still to be listed are kept at its start.
+ * @param ast the arena holding the tree
+ * @param root the root of the tree
+ * @return the number of nodes listed
+ */
+int ast_order(ast_t * ast, int root) {
+   int pending = 0;       // nodes still to be listed, a stack at the start of order
+   int first = ast->count; // where the list starts, at the end of order
+
+   if (ast->count > ast->walk_capacity) {
+      int capacity = ast->walk_capacity ? ast->walk_capacity : 64;
+      int *order;
+      long long *operands;
+
+      while (capacity < ast->count)
+         capacity *= 2;
+      order = realloc(ast->order, capacity * sizeof(int));
+      if (order == NULL)
+         out_of_memory("ERROR: out of memory for the syntax tree");
+      ast->order = order;
+      operands = realloc(ast->operands, capacity * sizeof(long long));
+      if (operands == NULL)
+         out_of_memory("ERROR: out of memory for the syntax tree");
+      ast->operands = operands;
+      ast->walk_capacity = capacity;
+   }
+
+   //every node is listed or pending at most once, so the two never meet
+   ast->order[pending++] = root;
+   while (pending > 0) {
+      int index = ast->order[--pending];
+      node_t *node = &ast->nodes[index];
+
+      ast->order[--first] = index;
+      if (node->kind != NUM_NODE && node->kind != VARIABLE_NODE) {
+         ast->order[pending++] = node->left;
+         if (node->right != NO_NODE)
+            ast->order[pending++] = node->right;
+      }
+   }
+   memmove(ast->order, ast->order + first, (ast->count - first) * sizeof(int));
+   return ast->count - first;
+}
+
+/**
+ * Works out the value of one node from those of its operands with the
+ * same arithmetic as parser.c, leaving a division that has no result in
+ * the status of the arena if it is the first
+ * @param ast the arena holding the node
+ * @param node the node
+ * @param left the value of its left operand, unused for a NUM_NODE or VARIABLE_NODE
+ * @param right the value of its right operand, unused without one
+ * @return the value of the node
+ */
+int ast_apply(ast_t * ast, node_t * node, int left, int right) {
+   switch (node->kind) {
+   case NUM_NODE:
+      return node->value;
+   case VARIABLE_NODE:
+      return ast->symbols->values[node->value];
+   case ADD_NODE:
+      return left + right;
+   case SUB_NODE:
+      return left - right;
+   case MULT_NODE:
+      return left * right;
+   case DIV_NODE:
+      return int_divide(left, right, &ast->status);
+   case EXPON_NODE:
+      return (int) pow(left, right);
+   case LESS_THEN_NODE:
+      return left < right;
+   case LESS_THEN_OR_EQUAL_NODE:
+      return left <= right;
+   case GREATER_THEN_NODE:
+      return left > right;
+   case GREATER_THEN_OR_EQUAL_NODE:
+      return left >= right;
+   case EQUALS_NODE:
+      return left == right;
+   case NOT_EQUALS_NODE:
+      return left != right;
+   case SQUARE_NODE:
+      //what pow() gives for an exponent of 2, overflow included
+      return (int) ((double) left * left);
+   case SHIFT_LEFT_NODE:
+      return (int) ((unsigned int) left << right);
+   case SHIFT_RIGHT_NODE:
+      //round toward zero like /, a negative left needs 2^right - 1 added first
+      return (left + ((left >> 31) & ((1 << right) - 1))) >> right;
+   default:
+      return node->value;
+   }
+}
+
+/**
+ * Evaluates the tree below a node with the same arithmetic as parser.c,
+ * leaving ARITH_OK in the status of the arena, or the first division
+ * that had no result
+ * @param ast the arena holding the tree
+ * @param root the node to evaluate
+ * @return the value of the node, of no use unless the status is ARITH_OK
+ */
+int ast_eval(ast_t * ast, int root) {
+   int count = ast_order(ast, root);
+   long long *top = ast->operands; // above the values of the nodes not yet used as operands
+   int i;
+
+   ast->status = ARITH_OK;
+   for (i = 0; i < count; i++) {
+      node_t *node = &ast->nodes[ast->order[i]];
+      int left = 0;
+      int right = 0;
+
+      if (node->kind != NUM_NODE && node->kind != VARIABLE_NODE) {
+         if (node->right != NO_NODE)
+            right = (int) *--top;
+         left = (int) *--top;
+      }
+      *top++ = ast_apply(ast, node, left, right);
+   }
+   return (int) ast->operands[0];
+}
@@ -0,0 +1,72 @@
+#ifndef AST_H
+   #define AST_H
+#define NO_NODE -1 // index returned when a statement could not be parsed
+
+/* kinds of nodes in the tree */
+enum node_kind {
+   NUM_NODE,
+   VARIABLE_NODE,    // the value of a variable, whose slot is in value
+   ADD_NODE,
+   SUB_NODE,
+   MULT_NODE,
+   DIV_NODE,
+   EXPON_NODE,
+   LESS_THEN_NODE,
+   LESS_THEN_OR_EQUAL_NODE,
+   GREATER_THEN_NODE,
+   GREATER_THEN_OR_EQUAL_NODE,
+   EQUALS_NODE,
+   NOT_EQUALS_NODE,
+   SQUARE_NODE,      // left * left, only made by optimize.c, has no right
+   SHIFT_LEFT_NODE,  // left * 2^right, only made by optimize.c
+   SHIFT_RIGHT_NODE  // left / 2^right, only made by optimize.c
+};
+
+/* a node of the tree, children are indexes into the same arena */
+typedef struct node {
+   enum node_kind kind;
+   int left;  // index of the left operand, or where the digits of a NUM_NODE start
+   int right; // index of the right operand, or how many digits a NUM_NODE has
+   int value; // value of a NUM_NODE as an int, or the slot of a VARIABLE_NODE
+} node_t;
+
+/* the arena that owns every node of the parsed statements */
+typedef struct ast {
+   node_t *nodes;
+   int count;
+   int capacity;
+   const char *line; // the line the digits of the NUM_NODEs are in
+   struct symbols *symbols; // the variables the VARIABLE_NODEs are slots of
+   int status; // ARITH_OK, or the first arithmetic error of the last ast_eval
+   int *order;          // the nodes of the tree ast_order last listed, operands first
+   long long *operands; // a stack of values, one per node of that tree at most
+   int walk_capacity;   // how many nodes order and operands have room for
+} ast_t;
+
+/*
+ * Purpose: Function Prototypes for ast.c
+ * Date:    October 17, 2026
+ */
+void ast_init(ast_t *);
+void ast_reset(ast_t *);
+void ast_free(ast_t *);
+int ast_node(ast_t *, enum node_kind, int, int);
+
+int parse_bexpr(context_t *, ast_t *, token_t *);
+int parse_expr(context_t *, ast_t *, token_t *);
+int parse_term(context_t *, ast_t *, token_t *);
+int parse_ttail(context_t *, ast_t *, token_t *, int);
+int parse_stmt(context_t *, ast_t *, token_t *);
+int parse_stail(context_t *, ast_t *, token_t *, int);
+int parse_factor(context_t *, ast_t *, token_t *);
+int parse_ftail(context_t *, ast_t *, token_t *, int);
+int parse_expp(context_t *, ast_t *, token_t *);
+int parse_num(context_t *, ast_t *, token_t *);
+int parse_name(context_t *, ast_t *, token_t *);
+
+int ast_order(ast_t *, int);
+int ast_apply(ast_t *, node_t *, int, int);
+int ast_eval(ast_t *, int);
+
+
+#endif
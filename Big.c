@@ -0,0 +1,656 @@
+/*
+ * big.c - integers of any size for the big arithmetic mode.
+ * Magnitudes are arrays of 32-bit limbs so that a product of two limbs
+ * and a carry fits in 64 bits. Multiplication is schoolbook for small
+ * operands and Karatsuba above KARATSUBA_MIN limbs, division is Knuth's
+ * algorithm D, and ^ squares and multiplies. Results larger than
+ * BIG_MAX_LIMBS are refused with ARITH_TOO_LARGE so a statement such as
+ * 9^999999999 fails instead of running out of memory.
+ * Date:   October 17, 2026
+ */
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <string.h>
+
+#include <stdint.h>
+
+#include "Output.h"
+
+#include "Big.h"
+
+#define LIMB_BITS 32
+#define BILLION 1000000000u // 10^9, the most decimal digits that fit in a limb
+
+
+/**
+ * Makes room for a number of limbs, keeping the ones already there
+ * @param big the number
+ * @param count the limbs needed
+ */
+static void reserve(big_t * big, int count) {
+   uint32_t *limbs;
+   int capacity;
+
+   if (count <= big->capacity)
+      return;
+
+   capacity = count < 2 * big->capacity ? 2 * big->capacity : count;
+   limbs = realloc(big->limbs, capacity * sizeof(uint32_t));
+   if (limbs == NULL)
+      out_of_memory("ERROR: out of memory for a big number");
+   big->limbs = limbs;
+   big->capacity = capacity;
+}
+
+/**
+ * Allocates limbs for a temporary result
+ * @param count the limbs needed
+ * @return the limbs
+ */
+static uint32_t * scratch(int count) {
+   uint32_t *limbs = malloc(count * sizeof(uint32_t));
+
+   if (limbs == NULL)
+      out_of_memory("ERROR: out of memory for a big number");
+   return limbs;
+}
+
+/**
+ * Drops leading zero limbs, zero is never negative
+ * @param big the number
+ */
+static void trim(big_t * big) {
+   while (big->count > 0 && big->limbs[big->count - 1] == 0)
+      big->count--;
+   if (big->count == 0)
+      big->negative = 0;
+}
+
+/**
+ * Compares two magnitudes without leading zero limbs
+ * @return -1, 0 or 1 as a is below, equal to or above b
+ */
+static int mag_compare(const uint32_t * a, int na, const uint32_t * b, int nb) {
+   if (na != nb)
+      return na < nb ? -1 : 1;
+   while (na-- > 0) {
+      if (a[na] != b[na])
+         return a[na] < b[na] ? -1 : 1;
+   }
+   return 0;
+}
+
+/**
+ * r = a + b, r has room for one more limb than the longer operand
+ * @return the number of limbs written to r
+ */
+static int mag_add(uint32_t * r, const uint32_t * a, int na, const uint32_t * b, int nb) {
+   uint64_t carry = 0;
+   int i;
+
+   if (na < nb) {
+      const uint32_t *swap = a;
+      int n = na;
+
+      a = b;
+      na = nb;
+      b = swap;
+      nb = n;
+   }
+   for (i = 0; i < nb; i++) {
+      carry += (uint64_t) a[i] + b[i];
+      r[i] = (uint32_t) carry;
+      carry >>= LIMB_BITS;
+   }
+   for (; i < na; i++) {
+      carry += a[i];
+      r[i] = (uint32_t) carry;
+      carry >>= LIMB_BITS;
+   }
+   r[na] = (uint32_t) carry;
+   return na + 1;
+}
+
+/**
+ * r = a - b where a is at least b, r has na limbs and may be a
+ */
+static void mag_sub(uint32_t * r, const uint32_t * a, int na, const uint32_t * b, int nb) {
+   uint64_t borrow = 0;
+   int i;
+
+   for (i = 0; i < nb; i++) {
+      uint64_t difference = (uint64_t) a[i] - b[i] - borrow;
+
+      r[i] = (uint32_t) difference;
+      borrow = (difference >> LIMB_BITS) & 1;
+   }
+   for (; i < na; i++) {
+      uint64_t difference = (uint64_t) a[i] - borrow;
+
+      r[i] = (uint32_t) difference;
+      borrow = (difference >> LIMB_BITS) & 1;
+   }
+}
+
+/**
+ * r += a, where the sum still fits in the nr limbs of r
+ */
+static void mag_add_into(uint32_t * r, int nr, const uint32_t * a, int na) {
+   uint64_t carry = 0;
+   int i;
+
+   for (i = 0; i < na; i++) {
+      carry += (uint64_t) r[i] + a[i];
+      r[i] = (uint32_t) carry;
+      carry >>= LIMB_BITS;
+   }
+   for (; carry != 0 && i < nr; i++) {
+      carry += r[i];
+      r[i] = (uint32_t) carry;
+      carry >>= LIMB_BITS;
+   }
+}
+
+/**
+ * r = a * b one limb at a time, r has na + nb limbs
+ */
+static void mag_mul_school(uint32_t * r, const uint32_t * a, int na, const uint32_t * b, int nb) {
+   int i;
+   int j;
+
+   memset(r, 0, (na + nb) * sizeof(uint32_t));
+   for (i = 0; i < na; i++) {
+      uint64_t carry = 0;
+
+      for (j = 0; j < nb; j++) {
+         carry += (uint64_t) a[i] * b[j] + r[i + j];
+         r[i + j] = (uint32_t) carry;
+         carry >>= LIMB_BITS;
+      }
+      r[i + nb] = (uint32_t) carry;
+   }
+}
+
+/**
+ * r = a * b, r has na + nb limbs and is not one of the operands.
+ * Splitting a = a1*B^m + a0 and b = b1*B^m + b0 needs three products
+ * instead of four: a0*b0, a1*b1 and (a0 + a1)(b0 + b1), from which the
+ * middle a0*b1 + a1*b0 is found by subtracting the other two.
+ * Operands may have leading zero limbs.
+ */
+static void mag_mul(uint32_t * r, const uint32_t * a, int na, const uint32_t * b, int nb) {
+   uint32_t *sum_a;
+   uint32_t *sum_b;
+   uint32_t *middle;
+   int m;
+   int la;
+   int lb;
+   int lm;
+
+   if (na < nb) {
+      const uint32_t *swap = a;
+      int n = na;
+
+      a = b;
+      na = nb;
+      b = swap;
+      nb = n;
+   }
+
+   //below 4 limbs the middle product would be no smaller than a * b
+   if (nb < KARATSUBA_MIN || nb < 4) {
+      mag_mul_school(r, a, na, b, nb);
+      return;
+   }
+
+   if (2 * nb <= na) {
+      //too lopsided to split evenly, multiply b by slices of a as long as b
+      uint32_t *part = scratch(2 * nb);
+      int i;
+
+      memset(r, 0, (na + nb) * sizeof(uint32_t));
+      for (i = 0; i < na; i += nb) {
+         int length = na - i < nb ? na - i : nb;
+
+         mag_mul(part, a + i, length, b, nb);
+         mag_add_into(r + i, na + nb - i, part, length + nb);
+      }
+      free(part);
+      return;
+   }
+
+   m = na / 2;
+
+   //a0*b0 and a1*b1 go straight to where they belong in r
+   mag_mul(r, a, m, b, m);
+   mag_mul(r + 2 * m, a + m, na - m, b + m, nb - m);
+
+   sum_a = scratch(na - m + 1);
+   sum_b = scratch((m > nb - m ? m : nb - m) + 1);
+   la = mag_add(sum_a, a, m, a + m, na - m);
+   lb = mag_add(sum_b, b, m, b + m, nb - m);
+
+   lm = la + lb;
+   middle = scratch(lm);
+   mag_mul(middle, sum_a, la, sum_b, lb);
+   mag_sub(middle, middle, lm, r, 2 * m);
+   mag_sub(middle, middle, lm, r + 2 * m, na + nb - 2 * m);
+   while (lm > 0 && middle[lm - 1] == 0)
+      lm--;
+   mag_add_into(r + m, na + nb - m, middle, lm);
+
+   free(middle);
+   free(sum_b);
+   free(sum_a);
+}
+
+/**
+ * q = u / v for a v of at least two limbs and a u at least as long,
+ * Knuth's algorithm D. q has nu - nv + 1 limbs.
+ */
+static void mag_div(uint32_t * q, const uint32_t * u, int nu, const uint32_t * v, int nv) {
+   uint32_t *un = scratch(nu + 1);
+   uint32_t *vn = scratch(nv);
+   uint32_t top = v[nv - 1];
+   int shift = 0;
+   int i;
+   int j;
+
+   //shift so the top limb of v has its high bit set
+   while (!(top & 0x80000000u)) {
+      top <<= 1;
+      shift++;
+   }
+   for (i = nv - 1; i > 0; i--)
+      vn[i] = (v[i] << shift) | (shift ? v[i - 1] >> (LIMB_BITS - shift) : 0);
+   vn[0] = v[0] << shift;
+   un[nu] = shift ? u[nu - 1] >> (LIMB_BITS - shift) : 0;
+   for (i = nu - 1; i > 0; i--)
+      un[i] = (u[i] << shift) | (shift ? u[i - 1] >> (LIMB_BITS - shift) : 0);
+   un[0] = u[0] << shift;
+
+   for (j = nu - nv; j >= 0; j--) {
+      uint64_t numerator = ((uint64_t) un[j + nv] << LIMB_BITS) | un[j + nv - 1];
+      uint64_t qhat = numerator / vn[nv - 1];
+      uint64_t rhat = numerator % vn[nv - 1];
+      int64_t borrow = 0;
+      int64_t t;
+
+      //the estimate is at most two too big
+      while (qhat >> LIMB_BITS
+             || qhat * vn[nv - 2] > ((rhat << LIMB_BITS) | un[j + nv - 2])) {
+         qhat--;
+         rhat += vn[nv - 1];
+         if (rhat >> LIMB_BITS)
+            break;
+      }
+
+      //un -= qhat * vn, shifted to j
+      for (i = 0; i < nv; i++) {
+         uint64_t product = qhat * vn[i];
+
+         t = (int64_t) un[i + j] - borrow - (int64_t) (product & 0xFFFFFFFFu);
+         un[i + j] = (uint32_t) t;
+         borrow = (int64_t) (product >> LIMB_BITS) - (t >> LIMB_BITS);
+      }
+      t = (int64_t) un[j + nv] - borrow;
+      un[j + nv] = (uint32_t) t;
+
+      q[j] = (uint32_t) qhat;
+      if (t < 0) {
+         //it was one too big, add vn back
+         uint64_t carry = 0;
+
+         q[j]--;
+         for (i = 0; i < nv; i++) {
+            carry += (uint64_t) un[i + j] + vn[i];
+            un[i + j] = (uint32_t) carry;
+            carry >>= LIMB_BITS;
+         }
+         un[j + nv] += (uint32_t) carry;
+      }
+   }
+
+   free(vn);
+   free(un);
+}
+
+/**
+ * Sets up a number with the value zero
+ * @param big the number
+ */
+void big_init(big_t * big) {
+   big->limbs = NULL;
+   big->count = 0;
+   big->capacity = 0;
+   big->negative = 0;
+}
+
+/**
+ * Releases the limbs of a number
+ * @param big the number
+ */
+void big_free(big_t * big) {
+   free(big->limbs);
+   big_init(big);
+}
+
+/**
+ * @param big the number
+ * @param value the value to give it
+ */
+void big_set(big_t * big, long long value) {
+   unsigned long long magnitude = value < 0 ? 0ull - (unsigned long long) value
+                                            : (unsigned long long) value;
+
+   reserve(big, 2);
+   big->limbs[0] = (uint32_t) magnitude;
+   big->limbs[1] = (uint32_t) (magnitude >> LIMB_BITS);
+   big->count = 2;
+   big->negative = value < 0;
+   trim(big);
+}
+
+/**
+ * @param to the number to set
+ * @param from the number to copy
+ */
+void big_copy(big_t * to, const big_t * from) {
+   reserve(to, from->count);
+   if (from->count > 0)
+      memcpy(to->limbs, from->limbs, from->count * sizeof(uint32_t));
+   to->count = from->count;
+   to->negative = from->negative;
+}
+
+/**
+ * Reads the decimal digits of an INT_LITERAL, nine digits at a time
+ * @param big the number to set
+ * @param digits the digits
+ * @param length the number of digits
+ */
+void big_digits(big_t * big, const char * digits, int length) {
+   int part = length % 9 ? length % 9 : 9;
+   int i = 0;
+   int j;
+
+   reserve(big, length / 9 + 2);
+   big->count = 0;
+   big->negative = 0;
+   while (i < length) {
+      uint64_t carry = 0;
+
+      for (; part > 0; part--)
+         carry = carry * 10 + (digits[i++] - '0');
+      part = 9;
+
+      for (j = 0; j < big->count; j++) {
+         carry += (uint64_t) big->limbs[j] * BILLION;
+         big->limbs[j] = (uint32_t) carry;
+         carry >>= LIMB_BITS;
+      }
+      if (carry != 0)
+         big->limbs[big->count++] = (uint32_t) carry;
+   }
+}
+
+/**
+ * @param big the number
+ * @param value where the value is stored if it fits
+ * @return 1 if the number fits in a long long, 0 otherwise
+ */
+int big_fits(const big_t * big, long long * value) {
+   unsigned long long magnitude = 0;
+
+   if (big->count > 2)
+      return 0;
+   if (big->count > 0)
+      magnitude = big->limbs[0];
+   if (big->count > 1)
+      magnitude |= (unsigned long long) big->limbs[1] << LIMB_BITS;
+
+   if (big->negative) {
+      if (magnitude > (unsigned long long) INT64_MAX + 1)
+         return 0;
+      *value = magnitude == (unsigned long long) INT64_MAX + 1 ? INT64_MIN : -(long long) magnitude;
+   } else {
+      if (magnitude > INT64_MAX)
+         return 0;
+      *value = (long long) magnitude;
+   }
+   return 1;
+}
+
+/**
+ * @return -1, 0 or 1 as a is below, equal to or above b
+ */
+int big_compare(const big_t * a, const big_t * b) {
+   if (a->negative != b->negative)
+      return a->negative ? -1 : 1;
+   if (a->negative)
+      return mag_compare(b->limbs, b->count, a->limbs, a->count);
+   return mag_compare(a->limbs, a->count, b->limbs, b->count);
+}
+
+/**
+ * r = a + b, where b has the given sign
+ */
+static int add_signed(big_t * r, const big_t * a, const big_t * b, int b_negative) {
+   if (a->negative == b_negative) {
+      reserve(r, (a->count > b->count ? a->count : b->count) + 1);
+      r->count = mag_add(r->limbs, a->limbs, a->count, b->limbs, b->count);
+      r->negative = a->negative;
+   } else if (mag_compare(a->limbs, a->count, b->limbs, b->count) >= 0) {
+      reserve(r, a->count);
+      mag_sub(r->limbs, a->limbs, a->count, b->limbs, b->count);
+      r->count = a->count;
+      r->negative = a->negative;
+   } else {
+      reserve(r, b->count);
+      mag_sub(r->limbs, b->limbs, b->count, a->limbs, a->count);
+      r->count = b->count;
+      r->negative = b_negative;
+   }
+   trim(r);
+   return r->count > BIG_MAX_LIMBS ? ARITH_TOO_LARGE : ARITH_OK;
+}
+
+/**
+ * r = a + b
+ * @return ARITH_OK or ARITH_TOO_LARGE
+ */
+int big_add(big_t * r, const big_t * a, const big_t * b) {
+   return add_signed(r, a, b, b->negative);
+}
+
+/**
+ * r = a - b
+ * @return ARITH_OK or ARITH_TOO_LARGE
+ */
+int big_sub(big_t * r, const big_t * a, const big_t * b) {
+   return add_signed(r, a, b, !b->negative);
+}
+
+/**
+ * r = a * b
+ * @return ARITH_OK or ARITH_TOO_LARGE
+ */
+int big_mul(big_t * r, const big_t * a, const big_t * b) {
+   if (a->count == 0 || b->count == 0) {
+      r->count = 0;
+      r->negative = 0;
+      return ARITH_OK;
+   }
+   //the product has at least a->count + b->count - 1 limbs
+   if (a->count + b->count - 1 > BIG_MAX_LIMBS)
+      return ARITH_TOO_LARGE;
+
+   reserve(r, a->count + b->count);
+   mag_mul(r->limbs, a->limbs, a->count, b->limbs, b->count);
+   r->count = a->count + b->count;
+   r->negative = a->negative != b->negative;
+   trim(r);
+   return r->count > BIG_MAX_LIMBS ? ARITH_TOO_LARGE : ARITH_OK;
+}
+
+/**
+ * r = a / b, rounded toward zero like C division
+ * @return ARITH_OK or ARITH_DIVIDE_BY_ZERO
+ */
+int big_div(big_t * r, const big_t * a, const big_t * b) {
+   if (b->count == 0)
+      return ARITH_DIVIDE_BY_ZERO;
+   if (mag_compare(a->limbs, a->count, b->limbs, b->count) < 0) {
+      r->count = 0;
+      r->negative = 0;
+      return ARITH_OK;
+   }
+
+   reserve(r, a->count - b->count + 1);
+   if (b->count == 1) {
+      uint64_t remainder = 0;
+      int i;
+
+      for (i = a->count - 1; i >= 0; i--) {
+         uint64_t current = (remainder << LIMB_BITS) | a->limbs[i];
+
+         r->limbs[i] = (uint32_t) (current / b->limbs[0]);
+         remainder = current % b->limbs[0];
+      }
+   } else {
+      mag_div(r->limbs, a->limbs, a->count, b->limbs, b->count);
+   }
+   r->count = a->count - b->count + 1;
+   r->negative = a->negative != b->negative;
+   trim(r);
+   return ARITH_OK;
+}
+
+/**
+ * r = base ^ exponent by repeated squaring. A negative exponent gives
+ * the integer part of 1 / base^-exponent, which is 0 unless base is 1
+ * or -1.
+ * @return ARITH_OK, ARITH_DIVIDE_BY_ZERO for 0 to a negative power, or
+ * ARITH_TOO_LARGE
+ */
+int big_pow(big_t * r, const big_t * base, const big_t * exponent) {
+   int odd = exponent->count > 0 && (exponent->limbs[0] & 1);
+   uint64_t power;
+   uint32_t top;
+   int bits = 0;
+   int bit;
+   int status = ARITH_OK;
+   big_t square;
+
+   if (exponent->count == 0) {
+      big_set(r, 1);
+      return ARITH_OK;
+   }
+   if (base->count == 0) {
+      if (exponent->negative)
+         return ARITH_DIVIDE_BY_ZERO;
+      big_set(r, 0);
+      return ARITH_OK;
+   }
+   if (base->count == 1 && base->limbs[0] == 1) {
+      big_set(r, base->negative && odd ? -1 : 1);
+      return ARITH_OK;
+   }
+   if (exponent->negative) {
+      big_set(r, 0);
+      return ARITH_OK;
+   }
+
+   //|base| is at least 2, so the result has more bits than the exponent
+   if (exponent->count > 2)
+      return ARITH_TOO_LARGE;
+   power = exponent->limbs[0];
+   if (exponent->count == 2)
+      power |= (uint64_t) exponent->limbs[1] << LIMB_BITS;
+   for (top = base->limbs[base->count - 1]; top > 0; top >>= 1)
+      bits++;
+   bits += (base->count - 1) * LIMB_BITS;
+   if (power > (uint64_t) BIG_MAX_LIMBS * LIMB_BITS / (bits - 1))
+      return ARITH_TOO_LARGE;
+
+   //square for each bit of the exponent below the top one, multiply for each 1
+   for (bit = 63; !(power >> bit & 1); bit--)
+      ;
+   big_init(&square);
+   big_copy(r, base);
+   while (bit-- > 0 && status == ARITH_OK) {
+      status = big_mul(&square, r, r);
+      if (status != ARITH_OK)
+         break;
+      if (power >> bit & 1) {
+         status = big_mul(r, &square, base);
+      } else {
+         big_t swap = *r;
+
+         *r = square;
+         square = swap;
+      }
+   }
+   big_free(&square);
+   return status;
+}
+
+/**
+ * Writes a number in decimal. Numbers that fit in a long long are
+ * written by output_long, others by dividing by 10^9 until nothing is
+ * left, nine digits at a time.
+ * @param output the output
+ * @param big the number
+ */
+void output_big(output_t * output, const big_t * big) {
+   long long value;
+   uint32_t *limbs;
+   char *digits;
+   char *end;
+   char *pos;
+   int count = big->count;
+   int i;
+
+   if (big_fits(big, &value)) {
+      output_long(output, value);
+      return;
+   }
+
+   //a limb is less than ten digits, plus one for the sign
+   limbs = scratch(count);
+   memcpy(limbs, big->limbs, count * sizeof(uint32_t));
+   digits = malloc(count * 10 + 1);
+   if (digits == NULL) {
+      free(limbs);
+      out_of_memory("ERROR: out of memory for a big number");
+   }
+   end = digits + count * 10 + 1;
+   pos = end;
+
+   while (count > 0) {
+      uint64_t remainder = 0;
+      int k;
+
+      for (i = count - 1; i >= 0; i--) {
+         uint64_t current = (remainder << LIMB_BITS) | limbs[i];
+
+         limbs[i] = (uint32_t) (current / BILLION);
+         remainder = current % BILLION;
+      }
+      while (count > 0 && limbs[count - 1] == 0)
+         count--;
+      //only the most significant group goes without its leading zeros
+      for (k = 0; k < 9 && (count > 0 || remainder > 0); k++) {
+         *--pos = '0' + remainder % 10;
+         remainder /= 10;
+      }
+   }
+   if (big->negative)
+      *--pos = '-';
+   output_write(output, pos, end - pos);
+
+   free(digits);
+   free(limbs);
+}
@@ -0,0 +1,63 @@
+#ifndef BIG_H
+   #define BIG_H
+
+#include <stdint.h>
+#include <limits.h>
+
+#ifndef KARATSUBA_MIN
+#define KARATSUBA_MIN 32 // fewer limbs than this are multiplied the schoolbook way
+#endif
+#define BIG_MAX_LIMBS 32768 // largest result kept, 1048576 bits
+
+/* how an operation ended, for big.c, the 64-bit operations in arith.c
+   and division in int arithmetic */
+enum arith_status {
+   ARITH_OK,
+   ARITH_OVERFLOW,         // the value does not fit in 64 bits
+   ARITH_DIVIDE_BY_ZERO,
+   ARITH_TOO_LARGE         // the value would need more than BIG_MAX_LIMBS
+};
+
+/*
+ * left / right in int arithmetic, which wraps around like C everywhere
+ * else but must not trap: dividing by 0 or INT_MIN by -1 gives 0 and
+ * sets *status, unless an operation before it already did
+ */
+static inline int int_divide(int left, int right, int * status) {
+   if (right == 0 || (right == -1 && left == INT_MIN)) {
+      if (*status == ARITH_OK)
+         *status = right == 0 ? ARITH_DIVIDE_BY_ZERO : ARITH_OVERFLOW;
+      return 0;
+   }
+   return left / right;
+}
+
+/* an integer of any size, stored as sign and magnitude */
+typedef struct big {
+   uint32_t *limbs; // magnitude, least significant limb first
+   int count;       // limbs in use, the top one is never 0, 0 for zero
+   int capacity;
+   int negative;    // 1 if the value is below zero
+} big_t;
+
+/*
+ * Purpose: Function Prototypes for big.c
+ *          The result of each operation must not be one of its operands.
+ * Date:    October 17, 2026
+ */
+void big_init(big_t *);
+void big_free(big_t *);
+void big_set(big_t *, long long);
+void big_copy(big_t *, const big_t *);
+void big_digits(big_t *, const char *, int);
+int big_fits(const big_t *, long long *);
+int big_compare(const big_t *, const big_t *);
+int big_add(big_t *, const big_t *, const big_t *);
+int big_sub(big_t *, const big_t *, const big_t *);
+int big_mul(big_t *, const big_t *, const big_t *);
+int big_div(big_t *, const big_t *, const big_t *);
+int big_pow(big_t *, const big_t *, const big_t *);
+void output_big(output_t *, const big_t *);
+
+
+#endif
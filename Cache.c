@@ -0,0 +1,260 @@
+/**
+ * cache.c - remembers what lines wrote so a repeated line is not lexed,
+ * parsed or evaluated again.
+ *
+ * Entries live in a hash table with a list through them in the order they
+ * were last used. Storing past the memory cap drops entries from the
+ * least recently used end until the new one fits.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./Cache.h"
+
+
+/**
+ * Sets up an empty cache.
+ *
+ * @param cache the cache
+ * @param max_bytes most memory the entries may take, 0 to turn it off
+ */
+void cache_init(cache_t *cache, size_t max_bytes) {
+    cache->buckets = NULL;
+    cache->bucket_count = 0;
+    cache->newest = NULL;
+    cache->oldest = NULL;
+    cache->entries = 0;
+    cache->bytes = 0;
+    cache->max_bytes = max_bytes;
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+/**
+ * Frees every entry.
+ *
+ * @param cache the cache
+ */
+void cache_free(cache_t *cache) {
+    cache_entry_t *entry = cache->newest;
+
+    while (entry != NULL) {
+        cache_entry_t *older = entry->older;
+
+        free(entry);
+        entry = older;
+    }
+    free(cache->buckets);
+    cache->buckets = NULL;
+    cache->bucket_count = 0;
+    cache->newest = NULL;
+    cache->oldest = NULL;
+    cache->entries = 0;
+    cache->bytes = 0;
+}
+
+/**
+ * Hashes the text of a line eight bytes at a time, so hashing a large
+ * input costs little next to reading it.
+ *
+ * @param key the text
+ * @param length its number of bytes
+ * @return the hash
+ */
+uint64_t cache_hash(const char *key, size_t length) {
+    uint64_t hash = 0x9e3779b97f4a7c15ULL ^ length;
+    uint64_t word;
+
+    while (length >= 8) {
+        memcpy(&word, key, 8);
+        hash = (hash ^ word) * 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 32;
+        key += 8;
+        length -= 8;
+    }
+    word = 0;
+    memcpy(&word, key, length);
+    hash = (hash ^ word) * 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+/**
+ * @param entry an entry
+ * @return what its line wrote
+ */
+const char *cache_output(cache_entry_t *entry) {
+    return (const char *) (entry + 1) + entry->key_length;
+}
+
+/**
+ * Takes an entry out of the list of use.
+ *
+ * @param cache the cache
+ * @param entry the entry
+ */
+static void unlink_entry(cache_t *cache, cache_entry_t *entry) {
+    if (entry->newer != NULL) {
+        entry->newer->older = entry->older;
+    } else {
+        cache->newest = entry->older;
+    }
+    if (entry->older != NULL) {
+        entry->older->newer = entry->newer;
+    } else {
+        cache->oldest = entry->newer;
+    }
+}
+
+/**
+ * Puts an entry at the most recently used end of the list.
+ *
+ * @param cache the cache
+ * @param entry the entry
+ */
+static void link_newest(cache_t *cache, cache_entry_t *entry) {
+    entry->newer = NULL;
+    entry->older = cache->newest;
+    if (cache->newest != NULL) {
+        cache->newest->newer = entry;
+    } else {
+        cache->oldest = entry;
+    }
+    cache->newest = entry;
+}
+
+/**
+ * Looks a line up, counting a hit or a miss. A hit becomes the most
+ * recently used entry.
+ *
+ * @param cache the cache
+ * @param key the text of the line
+ * @param length its number of bytes
+ * @param hash cache_hash of the text
+ * @return the entry, or NULL if the line has not been stored
+ */
+cache_entry_t *cache_find(cache_t *cache, const char *key, size_t length, uint64_t hash) {
+    cache_entry_t *entry = NULL;
+
+    if (cache->bucket_count > 0) {
+        entry = cache->buckets[hash & (cache->bucket_count - 1)];
+    }
+    while (entry != NULL && (entry->hash != hash || entry->key_length != length
+                             || memcmp(entry + 1, key, length) != 0)) {
+        entry = entry->next;
+    }
+
+    if (entry == NULL) {
+        cache->misses++;
+        return NULL;
+    }
+    cache->hits++;
+    if (entry != cache->newest) {
+        unlink_entry(cache, entry);
+        link_newest(cache, entry);
+    }
+    return entry;
+}
+
+/**
+ * Takes an entry out of its bucket and the list of use, and frees it.
+ *
+ * @param cache the cache
+ * @param entry the entry
+ */
+static void remove_entry(cache_t *cache, cache_entry_t *entry) {
+    cache_entry_t **link = &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+
+    while (*link != entry) {
+        link = &(*link)->next;
+    }
+    *link = entry->next;
+    unlink_entry(cache, entry);
+    cache->bytes -= sizeof(cache_entry_t) + entry->key_length + entry->output_length;
+    cache->entries--;
+    free(entry);
+}
+
+/**
+ * Doubles the buckets, or makes the first ones, and moves every entry over.
+ * Without the memory for them, the buckets stay as they were.
+ *
+ * @param cache the cache
+ */
+static void grow(cache_t *cache) {
+    size_t count = cache->bucket_count ? cache->bucket_count * 2 : CACHE_BUCKETS;
+    cache_entry_t **buckets = calloc(count, sizeof(cache_entry_t *));
+    cache_entry_t *entry;
+
+    if (buckets == NULL) {
+        return;
+    }
+    for (entry = cache->newest; entry != NULL; entry = entry->older) {
+        cache_entry_t **bucket = &buckets[entry->hash & (count - 1)];
+
+        entry->next = *bucket;
+        *bucket = entry;
+    }
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucket_count = count;
+}
+
+/**
+ * Stores what a line wrote and found as the most recently used entry.
+ * The line must not be stored already. An entry bigger than the whole
+ * cache, or one there is no memory for, is not stored.
+ *
+ * @param cache the cache
+ * @param key the text of the line
+ * @param length its number of bytes
+ * @param hash cache_hash of the text
+ * @param output what the line wrote
+ * @param output_length its number of bytes
+ * @param statements statements that had a value
+ * @param errors 1 if the line stopped at an error
+ * @param by_kind its errors by kind
+ * @param value value of the last statement that had one
+ */
+void cache_store(cache_t *cache, const char *key, size_t length, uint64_t hash,
+                 const char *output, size_t output_length,
+                 int statements, int errors, const cache_errors_t *by_kind, int value) {
+    size_t size = sizeof(cache_entry_t) + length + output_length;
+    cache_entry_t *entry;
+    cache_entry_t **bucket;
+
+    if (size > cache->max_bytes) {
+        return;
+    }
+    while (cache->bytes + size > cache->max_bytes) {
+        remove_entry(cache, cache->oldest);
+    }
+    if (cache->entries >= cache->bucket_count) {
+        grow(cache);
+    }
+
+    entry = cache->bucket_count > 0 ? malloc(size) : NULL;
+    if (entry == NULL) {
+        return;
+    }
+    entry->hash = hash;
+    entry->key_length = length;
+    entry->output_length = output_length;
+    entry->statements = statements;
+    entry->errors = errors;
+    entry->by_kind = *by_kind;
+    entry->value = value;
+    memcpy(entry + 1, key, length);
+    memcpy((char *) (entry + 1) + length, output, output_length);
+
+    bucket = &cache->buckets[hash & (cache->bucket_count - 1)];
+    entry->next = *bucket;
+    *bucket = entry;
+    link_newest(cache, entry);
+    cache->bytes += size;
+    cache->entries++;
+}
@@ -0,0 +1,70 @@
+#ifndef CACHE_H
+   #define CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CACHE_BUCKETS 1024 // buckets of an empty cache, doubled as it fills
+
+/*
+ * The errors of one line by kind. Arithmetic errors are always counted,
+ * the others only with --stats, which is what they are kept for: a line
+ * found in a cache is not lexed or evaluated, so its errors are added
+ * from here.
+ */
+typedef struct cache_errors {
+    int32_t lexical;
+    int32_t syntax;
+    int32_t name;
+    int32_t arithmetic;        // statements that divided by zero or overflowed
+    int32_t depth;
+} cache_errors_t;
+
+/*
+ * What running one line wrote and found. The key and the output are kept
+ * right after the entry in the same allocation.
+ */
+typedef struct cache_entry {
+    struct cache_entry *next;  // next entry in the same bucket
+    struct cache_entry *newer; // neighbours in the order they were last used
+    struct cache_entry *older;
+    uint64_t hash;
+    size_t key_length;
+    size_t output_length;
+    int statements;            // statements that had a value
+    int errors;                // 1 if the line stopped at an error
+    cache_errors_t by_kind;    // its errors by kind
+    int value;                 // value of the last statement that had one
+} cache_entry_t;
+
+/*
+ * Lines run before, found by the hash of their text and dropped least
+ * recently used first once they take more than max_bytes.
+ */
+typedef struct cache {
+    cache_entry_t **buckets;
+    size_t bucket_count;
+    cache_entry_t *newest;
+    cache_entry_t *oldest;
+    size_t entries;
+    size_t bytes;      // size of every entry with its key and output
+    size_t max_bytes;  // 0 if the cache is off
+    long hits;
+    long misses;
+} cache_t;
+
+/*
+ * Purpose: Function Prototypes for cache.c
+ * Date:    October 17, 2026
+ */
+void cache_init(cache_t *cache, size_t max_bytes);
+void cache_free(cache_t *cache);
+uint64_t cache_hash(const char *key, size_t length);
+cache_entry_t *cache_find(cache_t *cache, const char *key, size_t length, uint64_t hash);
+const char *cache_output(cache_entry_t *entry);
+void cache_store(cache_t *cache, const char *key, size_t length, uint64_t hash,
+                 const char *output, size_t output_length,
+                 int statements, int errors, const cache_errors_t *by_kind, int value);
+
+
+#endif
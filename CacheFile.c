@@ -0,0 +1,404 @@
+/**
+ * cachefile.c - keeps what every line of an input wrote in a file, so
+ * running the same input again only lexes and evaluates the lines that
+ * changed and copies the output of the rest straight out of the file.
+ *
+ * The file holds the output of each line, echo included, in input order,
+ * then a record for each line and a hash table of the records:
+ *
+ *     header | outputs | records[lines] | table[table_size]
+ *
+ * A line is looked up at the record after the last one found, which is
+ * where it is when nothing above it changed, and through the table when
+ * lines were added or removed. Its echo has to match the cached one byte
+ * for byte, so a hash collision only costs a miss. A line that used a
+ * variable is run again even when it is found, since what it writes
+ * depends on the lines before it. Lines found one after
+ * the other have their outputs next to each other in the file and are
+ * written with one call. The new file is written next to the old one and
+ * renamed over it at the end, so a run that stops part way leaves the old
+ * file as it was.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Library.h"
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Ast.h"
+#include "Big.h"
+#include "Arith.h"
+#include "Vm.h"
+#include "Iterative.h"
+#include "Cache.h"
+#include "Arena.h"
+#include "Stats.h"
+#include "Input.h"
+#include "Symbols.h"
+#include "Interpreter.h"
+
+#define CACHE_MAGIC "INTCACHE"
+#define CACHE_VERSION 3
+
+/* the start of a cache file */
+typedef struct cache_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t padding;
+    uint64_t settings;    // hash of the options that change what a line writes
+    uint64_t lines;       // records in the file
+    uint64_t output_size; // bytes of output, padded to a multiple of 8
+    uint64_t table_size;  // slots in the table, a power of two
+} cache_header_t;
+
+/* what one line wrote and found */
+typedef struct cache_record {
+    uint64_t hash;        // cache_hash of the line, with its '\n'
+    uint64_t offset;      // where its output starts, from the first output
+    uint32_t length;      // bytes of output, its echo first
+    int32_t statements;   // statements that had a value
+    int32_t errors;       // 1 if the line stopped at an error
+    int32_t value;        // value of the last statement that had one
+    int32_t stateful;     // 1 if the line used a variable, so it is run every time
+    cache_errors_t by_kind; // its errors by kind, lexical to depth only with --stats
+    uint32_t padding;
+} cache_record_t;
+
+/* an old cache file mapped in, and the new one being written */
+typedef struct cache_file {
+    const char *outputs;           // outputs of the old file, NULL if there is none
+    const cache_record_t *records;
+    const uint64_t *table;         // record index + 1 for each slot, 0 if empty
+    uint64_t output_size;
+    uint64_t lines;
+    uint64_t table_size;
+    uint64_t next;                 // record after the last one found
+    void *map;
+    size_t map_size;
+    output_t file;                 // the new file
+    cache_record_t *new_records;
+    uint64_t new_lines;
+    uint64_t new_capacity;
+    uint64_t new_size;             // bytes of output written to the new file
+    const char *pending;           // old outputs found in a row, not written yet
+    size_t pending_length;
+} cache_file_t;
+
+
+/**
+ * @param worker the worker running the lines
+ * @return a hash of every option that changes what a line writes
+ */
+static uint64_t settings_hash(worker_t *worker) {
+    int32_t settings[7];
+
+    settings[0] = worker->engine;
+    settings[1] = worker->arith;
+    settings[2] = worker->iterative;
+    settings[3] = worker->stack.max_depth;
+    settings[4] = worker->optimize;
+    settings[5] = worker->dump;
+    //a file written without --stats has no counts of lexical to depth errors
+    settings[6] = worker->ctx.stats != NULL;
+    return cache_hash((const char *) settings, sizeof(settings));
+}
+
+/**
+ * Maps an old cache file if there is one that was written with the same
+ * options and is not cut short.
+ *
+ * @param cache the cache
+ * @param path the file
+ * @param settings hash of the options of this run
+ */
+static void map_old(cache_file_t *cache, const char *path, uint64_t settings) {
+    const cache_header_t *header;
+    struct stat info;
+    size_t size;
+    int fd = open(path, O_RDONLY);
+
+    cache->outputs = NULL;
+    cache->map = NULL;
+    if (fd < 0) {
+        return;
+    }
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(cache_header_t)) {
+        close(fd);
+        return;
+    }
+    cache->map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (cache->map == MAP_FAILED) {
+        cache->map = NULL;
+        return;
+    }
+    cache->map_size = info.st_size;
+
+    header = cache->map;
+    size = cache->map_size - sizeof(cache_header_t);
+    if (memcmp(header->magic, CACHE_MAGIC, 8) != 0 || header->version != CACHE_VERSION
+        || header->settings != settings || header->output_size % 8 != 0
+        || header->output_size > size || header->lines > size / sizeof(cache_record_t)
+        || header->table_size > size / sizeof(uint64_t)
+        || header->table_size == 0 || (header->table_size & (header->table_size - 1)) != 0
+        || size - header->output_size != header->lines * sizeof(cache_record_t)
+                                         + header->table_size * sizeof(uint64_t)) {
+        munmap(cache->map, cache->map_size);
+        cache->map = NULL;
+        return;
+    }
+    cache->outputs = (const char *) (header + 1);
+    cache->records = (const cache_record_t *) (cache->outputs + header->output_size);
+    cache->table = (const uint64_t *) (cache->records + header->lines);
+    cache->output_size = header->output_size;
+    cache->lines = header->lines;
+    cache->table_size = header->table_size;
+}
+
+/**
+ * Looks a line up in the old file.
+ *
+ * @param cache the cache
+ * @param line the line
+ * @param length its number of bytes
+ * @param hash cache_hash of the line
+ * @return its record, or NULL if the old file does not have it
+ */
+static const cache_record_t *find(cache_file_t *cache, const char *line, size_t length,
+                                  uint64_t hash) {
+    const cache_record_t *record;
+    uint64_t slot;
+    uint64_t index = cache->next;
+
+    if (cache->outputs == NULL) {
+        return NULL;
+    }
+    if (index >= cache->lines || cache->records[index].hash != hash) {
+        //the line moved, or is new
+        index = cache->lines;
+        for (slot = hash & (cache->table_size - 1); cache->table[slot] != 0;
+             slot = (slot + 1) & (cache->table_size - 1)) {
+            if (cache->table[slot] <= cache->lines
+                && cache->records[cache->table[slot] - 1].hash == hash) {
+                index = cache->table[slot] - 1;
+                break;
+            }
+        }
+        if (index == cache->lines) {
+            return NULL;
+        }
+    }
+    //a damaged file can only cause misses
+    record = &cache->records[index];
+    if (record->offset > cache->output_size || record->length > cache->output_size - record->offset
+        || record->length < length || memcmp(cache->outputs + record->offset, line, length) != 0) {
+        return NULL;
+    }
+    cache->next = index + 1;
+    return record;
+}
+
+/**
+ * Adds a record for a line whose output was just written to the new file.
+ *
+ * @param cache the cache
+ * @param hash cache_hash of the line
+ * @param length bytes of output the line wrote
+ * @param statements statements that had a value
+ * @param errors 1 if the line stopped at an error
+ * @param by_kind its errors by kind
+ * @param value value of the last statement that had one
+ * @param stateful 1 if the line used a variable
+ */
+static void add_record(cache_file_t *cache, uint64_t hash, size_t length, int statements,
+                       int errors, const cache_errors_t *by_kind, int value, int stateful) {
+    cache_record_t *record;
+
+    if (cache->new_lines == cache->new_capacity) {
+        cache->new_capacity = cache->new_capacity ? cache->new_capacity * 2 : 4096;
+        cache->new_records = realloc(cache->new_records, cache->new_capacity * sizeof(cache_record_t));
+        if (cache->new_records == NULL) {
+            fprintf(stderr, "ERROR: out of memory for the cache file\n");
+            exit(1);
+        }
+    }
+    record = &cache->new_records[cache->new_lines++];
+    record->hash = hash;
+    record->offset = cache->new_size;
+    record->length = length;
+    record->statements = statements;
+    record->errors = errors;
+    record->by_kind = *by_kind;
+    record->value = value;
+    record->stateful = stateful;
+    record->padding = 0;
+    cache->new_size += length;
+}
+
+/**
+ * Writes the old outputs found in a row to the output and the new file.
+ *
+ * @param cache the cache
+ * @param out where the results are written
+ */
+static void write_pending(cache_file_t *cache, output_t *out) {
+    if (cache->pending_length > 0) {
+        output_write(out, cache->pending, cache->pending_length);
+        output_write(&cache->file, cache->pending, cache->pending_length);
+        cache->pending_length = 0;
+    }
+}
+
+/**
+ * Ends the new file with its records and table and writes its header.
+ *
+ * @param cache the cache
+ * @param settings hash of the options of this run
+ */
+static void finish(cache_file_t *cache, uint64_t settings) {
+    static const char zeros[8] = {0};
+    cache_header_t header;
+    uint64_t *table;
+    uint64_t slot;
+    uint64_t i;
+
+    output_write(&cache->file, zeros, (8 - cache->new_size % 8) % 8);
+    output_write(&cache->file, (const char *) cache->new_records,
+                 cache->new_lines * sizeof(cache_record_t));
+
+    memset(&header, 0, sizeof(header));
+    for (header.table_size = 16; header.table_size < 2 * cache->new_lines; header.table_size *= 2) {
+    }
+    table = calloc(header.table_size, sizeof(uint64_t));
+    if (table == NULL) {
+        fprintf(stderr, "ERROR: out of memory for the cache file\n");
+        exit(1);
+    }
+    for (i = 0; i < cache->new_lines; i++) {
+        for (slot = cache->new_records[i].hash & (header.table_size - 1); table[slot] != 0;
+             slot = (slot + 1) & (header.table_size - 1)) {
+            if (cache->new_records[table[slot] - 1].hash == cache->new_records[i].hash) {
+                break;
+            }
+        }
+        if (table[slot] == 0) {
+            table[slot] = i + 1;
+        }
+    }
+    output_write(&cache->file, (const char *) table, header.table_size * sizeof(uint64_t));
+    output_flush(&cache->file);
+    free(table);
+
+    memcpy(header.magic, CACHE_MAGIC, 8);
+    header.version = CACHE_VERSION;
+    header.settings = settings;
+    header.lines = cache->new_lines;
+    header.output_size = (cache->new_size + 7) / 8 * 8;
+    if (pwrite(cache->file.fd, &header, sizeof(header), 0) != sizeof(header)) {
+        fprintf(stderr, "ERROR: could not write the cache file\n");
+        exit(1);
+    }
+}
+
+/**
+ * Runs every line of the input, taking the output of lines that have not
+ * changed since the last run from the cache file, and leaves a cache file
+ * for the next run. Runs on one thread.
+ *
+ * @param worker the worker, which echoes the lines
+ * @param input the input
+ * @param out where the results are written
+ * @param path the cache file
+ */
+void run_cache_file(worker_t * worker, input_t * input, output_t * out, const char * path) {
+    static const cache_header_t empty;
+    cache_file_t cache;
+    uint64_t settings = settings_hash(worker);
+    char *temporary = malloc(strlen(path) + 5);
+    const cache_record_t *record;
+    output_t scratch;
+    const char *line;
+    size_t length;
+
+    if (temporary == NULL) {
+        fprintf(stderr, "ERROR: out of memory for the cache file\n");
+        exit(1);
+    }
+    sprintf(temporary, "%s.new", path);
+    memset(&cache, 0, sizeof(cache));
+    map_old(&cache, path, settings);
+    if (!output_open(&cache.file, temporary)) {
+        fprintf(stderr, "ERROR: could not open %s for writing\n", temporary);
+        exit(1);
+    }
+    output_write(&cache.file, (const char *) &empty, sizeof(empty));
+    output_memory(&scratch);
+
+    while (input_next_line(input, &line, &length)) {
+        uint64_t hash = cache_hash(line, length);
+
+        record = find(&cache, line, length, hash);
+        if (record != NULL && !record->stateful) {
+            const char *output = cache.outputs + record->offset;
+
+            if (cache.pending_length == 0 || output != cache.pending + cache.pending_length) {
+                write_pending(&cache, out);
+                cache.pending = output;
+            }
+            cache.pending_length += record->length;
+            worker->statements += record->statements;
+            worker->errors += record->errors;
+            worker_add_errors(worker, &record->by_kind);
+            if (worker->ctx.stats != NULL) {
+                worker->ctx.stats->lines++;
+            }
+            if (record->statements > 0) {
+                worker->value = record->value;
+            }
+            add_record(&cache, hash, record->length, record->statements, record->errors,
+                       &record->by_kind, record->value, 0);
+        } else {
+            int statements = worker->statements;
+            int errors = worker->errors;
+            cache_errors_t by_kind;
+
+            write_pending(&cache, out);
+            worker_errors(worker, &by_kind);
+            worker->ctx.out = &scratch;
+            run_line(worker, line, length);
+            worker->ctx.out = out;
+            worker_errors_since(worker, &by_kind);
+            output_write(out, scratch.data, scratch.size);
+            output_write(&cache.file, scratch.data, scratch.size);
+            add_record(&cache, hash, scratch.size, worker->statements - statements,
+                       worker->errors - errors, &by_kind, worker->value, worker->ctx.stateful);
+            scratch.size = 0;
+        }
+    }
+    write_pending(&cache, out);
+
+    //the old outputs must reach out before they are unmapped
+    output_flush(out);
+    finish(&cache, settings);
+    output_close(&cache.file);
+    if (rename(temporary, path) != 0) {
+        fprintf(stderr, "ERROR: could not replace %s\n", path);
+        exit(1);
+    }
+    if (cache.map != NULL) {
+        munmap(cache.map, cache.map_size);
+    }
+    free(cache.new_records);
+    free(scratch.data);
+    free(temporary);
+}
@@ -0,0 +1,751 @@
+/**
+ * column.c - evaluates one expression over every row of a table of
+ * columns, for -x.
+ *
+ * The expression is parsed once, with the name of each column interned
+ * first so its slot is the index of the column, and compiled to steps:
+ * one per operator, and one per column or part of the tree without
+ * variables, which is worked out once. The steps then run
+ * over BATCH_ROWS rows at a time, each operator as a loop over arrays
+ * that the compiler can vectorize, instead of the tree being walked once
+ * per row. Values are 64 bits and checked as with -a checked: a row keeps
+ * the first error found in the order ast_eval_checked would find it, and
+ * the operators after it run on whatever values it was left with.
+ *
+ * A table is read from CSV, a header line of names and then a line of
+ * values per row, or from a binary column file as described in column.h,
+ * whose columns are used where they are in the mapping. The result is
+ * written in the same format as the table.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "Library.h"
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Ast.h"
+#include "Big.h"
+#include "Arith.h"
+#include "Vm.h"
+#include "Iterative.h"
+#include "Cache.h"
+#include "Arena.h"
+#include "Stats.h"
+#include "Optimize.h"
+#include "Input.h"
+#include "Symbols.h"
+#include "Column.h"
+#include "Interpreter.h"
+
+#define CSV_ROWS 4096 // rows a column of a CSV file has room for at first
+
+/* gives each row that has no error yet the one an operator found */
+#define FAIL(i, failed, code) (status[i] = status[i] ? status[i] : (failed) ? (code) : ARITH_OK)
+
+
+/**
+ * Sets up a table without columns.
+ *
+ * @param table the table
+ */
+void table_init(table_t *table) {
+    memset(table, 0, sizeof(table_t));
+}
+
+/**
+ * Frees the names of a table, and its columns unless they are in a
+ * mapped file.
+ *
+ * @param table the table
+ */
+void table_free(table_t *table) {
+    int i;
+
+    for (i = 0; i < table->count; i++) {
+        free(table->names[i]);
+        if (!table->binary) {
+            free((void *) table->columns[i]);
+        }
+    }
+    free(table->names);
+    free(table->columns);
+    table_init(table);
+}
+
+/**
+ * Adds a column without values.
+ *
+ * @param table the table
+ * @param name the name of the column, not '\0' terminated
+ * @param length the number of bytes in the name
+ */
+static void add_column(table_t *table, const char *name, size_t length) {
+    table->names = realloc(table->names, (table->count + 1) * sizeof(char *));
+    table->columns = realloc(table->columns, (table->count + 1) * sizeof(long long *));
+    if (table->names == NULL || table->columns == NULL
+        || (table->names[table->count] = malloc(length + 1)) == NULL) {
+        fprintf(stderr, "ERROR: out of memory for a column\n");
+        exit(1);
+    }
+    memcpy(table->names[table->count], name, length);
+    table->names[table->count][length] = '\0';
+    table->columns[table->count] = NULL;
+    table->count++;
+}
+
+/**
+ * Finds the columns of a binary column file in its mapping.
+ *
+ * @param table the table
+ * @param input the file, which is mapped
+ * @param path its name, for errors
+ */
+static void read_binary(table_t *table, input_t *input, const char *path) {
+    column_header_t header;
+    size_t pos = sizeof(column_header_t);
+    uint32_t i;
+
+    if (input->size < sizeof(column_header_t)) {
+        fprintf(stderr, "ERROR: %s is too short for a column file\n", path);
+        exit(1);
+    }
+    memcpy(&header, input->data, sizeof(column_header_t));
+    if (header.version != COLUMN_VERSION) {
+        fprintf(stderr, "ERROR: %s is a column file of version %u, not %d\n",
+                path, header.version, COLUMN_VERSION);
+        exit(1);
+    }
+
+    table->binary = 1;
+    for (i = 0; i < header.columns; i++) {
+        uint32_t length;
+
+        if (input->size - pos < sizeof(uint32_t)) {
+            break;
+        }
+        memcpy(&length, input->data + pos, sizeof(uint32_t));
+        pos += sizeof(uint32_t);
+        if (input->size - pos < length) {
+            break;
+        }
+        add_column(table, input->data + pos, length);
+        pos += length;
+    }
+    pos = (pos + 7) & ~(size_t) 7;
+    if (i < header.columns || pos > input->size
+        || (input->size - pos) / sizeof(long long) / (header.columns ? header.columns : 1) < header.rows) {
+        fprintf(stderr, "ERROR: %s is cut short\n", path);
+        exit(1);
+    }
+
+    table->rows = header.rows;
+    for (i = 0; i < header.columns; i++) {
+        table->columns[i] = (const long long *) (input->data + pos) + i * header.rows;
+    }
+}
+
+/**
+ * Reads one value of a CSV line.
+ *
+ * @param pos the first byte of the value, moved past it and its ','
+ * @param end the end of the line
+ * @param value where the value is stored
+ * @return 1 if it was a number that fits in 64 bits, 0 otherwise
+ */
+static int csv_value(const char **pos, const char *end, long long *value) {
+    const char *p = *pos;
+    unsigned long long magnitude = 0;
+    unsigned long long limit;
+    int negative = 0;
+
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p++ == '-';
+    }
+    limit = negative ? (unsigned long long) LLONG_MAX + 1 : LLONG_MAX;
+    if (p == end || *p < '0' || *p > '9') {
+        return 0;
+    }
+    while (p < end && *p >= '0' && *p <= '9') {
+        unsigned digit = *p++ - '0';
+
+        if (magnitude > (limit - digit) / 10) {
+            return 0;
+        }
+        magnitude = magnitude * 10 + digit;
+    }
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    if (p < end && *p++ != ',') {
+        return 0;
+    }
+    *value = negative ? (long long) (0ull - magnitude) : (long long) magnitude;
+    *pos = p;
+    return 1;
+}
+
+/**
+ * Reads the columns of a CSV file: a line of names, then a line of values
+ * for each row. Lines with nothing on them are skipped.
+ *
+ * @param table the table
+ * @param input the file
+ * @param path its name, for errors
+ * @param line the line of names
+ * @param length the number of bytes in it
+ */
+static void read_csv(table_t *table, input_t *input, const char *path,
+                     const char *line, size_t length) {
+    const char *end = line + length;
+    long long **columns;
+    long capacity = CSV_ROWS;
+    long number = 1; // of the line being read
+    int i;
+
+    while (line < end) {
+        const char *comma = memchr(line, ',', end - line);
+        const char *last = comma != NULL ? comma : end;
+        const char *first = line;
+
+        while (first < last && (*first == ' ' || *first == '\t')) {
+            first++;
+        }
+        while (last > first && (last[-1] == ' ' || last[-1] == '\t'
+                                || last[-1] == '\r' || last[-1] == '\n')) {
+            last--;
+        }
+        add_column(table, first, last - first);
+        line = comma != NULL ? comma + 1 : end;
+    }
+
+    columns = (long long **) table->columns;
+    for (i = 0; i < table->count; i++) {
+        if ((columns[i] = malloc(capacity * sizeof(long long))) == NULL) {
+            fprintf(stderr, "ERROR: out of memory for a column\n");
+            exit(1);
+        }
+    }
+
+    while (input_next_line(input, &line, &length)) {
+        const char *pos = line;
+
+        end = line + length;
+        number++;
+        while (end > line && (end[-1] == '\n' || end[-1] == '\r' || end[-1] == '\0')) {
+            end--;
+        }
+        if (end == line) {
+            continue;
+        }
+        if (table->rows == capacity) {
+            capacity *= 2;
+            for (i = 0; i < table->count; i++) {
+                if ((columns[i] = realloc(columns[i], capacity * sizeof(long long))) == NULL) {
+                    fprintf(stderr, "ERROR: out of memory for a column\n");
+                    exit(1);
+                }
+            }
+        }
+        for (i = 0; i < table->count; i++) {
+            if (!csv_value(&pos, end, &columns[i][table->rows])
+                || (i + 1 < table->count) != (pos[-1] == ',')) {
+                fprintf(stderr, "ERROR: line %ld of %s should have %d numbers of 64 bits\n",
+                        number, path, table->count);
+                exit(1);
+            }
+        }
+        table->rows++;
+    }
+}
+
+/**
+ * Reads a table from a CSV file, or from a binary column file when the
+ * input is mapped and starts with COLUMN_MAGIC.
+ *
+ * @param table the table, whose columns may point into the input
+ *              until it is closed
+ * @param input the file
+ * @param path its name, for errors
+ */
+void table_read(table_t *table, input_t *input, const char *path) {
+    const char *line;
+    size_t length;
+
+    table_init(table);
+    if (input->mapped && input->size >= 4 && memcmp(input->data, COLUMN_MAGIC, 4) == 0) {
+        read_binary(table, input, path);
+        return;
+    }
+    if (!input_next_line(input, &line, &length)) {
+        fprintf(stderr, "ERROR: %s has no line of column names\n", path);
+        exit(1);
+    }
+    if (length >= 4 && memcmp(line, COLUMN_MAGIC, 4) == 0) {
+        fprintf(stderr, "ERROR: a column file has to be read from a regular file, not %s\n", path);
+        exit(1);
+    }
+    read_csv(table, input, path, line, length);
+}
+
+/**
+ * Sets up a batch without steps.
+ *
+ * @param batch the batch
+ */
+void batch_init(batch_t *batch) {
+    memset(batch, 0, sizeof(batch_t));
+}
+
+/**
+ * Frees the steps of a batch and their values.
+ *
+ * @param batch the batch
+ */
+void batch_free(batch_t *batch) {
+    free(batch->steps);
+    free(batch->registers);
+    free(batch->operands);
+    batch_init(batch);
+}
+
+/**
+ * Adds a step after the others.
+ *
+ * @param batch the batch
+ * @param step the step
+ */
+static void add_step(batch_t *batch, const step_t *step) {
+    if (batch->count == batch->capacity) {
+        batch->capacity = batch->capacity ? 2 * batch->capacity : 16;
+        batch->steps = realloc(batch->steps, batch->capacity * sizeof(step_t));
+        if (batch->steps == NULL) {
+            fprintf(stderr, "ERROR: out of memory for the steps of an expression\n");
+            exit(1);
+        }
+    }
+    batch->steps[batch->count++] = *step;
+}
+
+/**
+ * Replaces the steps of a batch with those of a tree that was not
+ * optimized, whose variables are the columns of a table, and fills a
+ * block with the value of each part of it without variables.
+ *
+ * @param batch the batch
+ * @param ast the arena holding the tree
+ * @param root the root of the tree
+ */
+void batch_compile(batch_t *batch, ast_t *ast, int root) {
+    int count = ast_order(ast, root);
+    long long *top = ast->operands; // above the step of each operand not yet used
+    int i;
+    int j;
+
+    //operands come before their operator in the order, and a part without
+    //variables is one step by the time its operator is reached, so when
+    //both operands are numbers they are the last two steps
+    batch->count = 0;
+    for (i = 0; i < count; i++) {
+        node_t *node = &ast->nodes[ast->order[i]];
+        step_t step;
+
+        step.kind = node->kind;
+        step.left = NO_NODE;
+        step.right = NO_NODE;
+        step.column = NO_SLOT;
+        step.value = 0;
+        step.status = ARITH_OK;
+        if (node->kind == VARIABLE_NODE) {
+            step.column = node->value;
+        } else if (node->kind == NUM_NODE) {
+            step.status = checked_apply(ast, node, 0, 0, &step.value);
+        } else {
+            step.right = (int) *--top;
+            step.left = (int) *--top;
+        }
+        if (step.left != NO_NODE && batch->steps[step.left].kind == NUM_NODE
+            && batch->steps[step.right].kind == NUM_NODE) {
+            //worked out once, stopping at the first error as ast_eval_checked would
+            step_t *left = &batch->steps[step.left];
+            step_t *right = &batch->steps[step.right];
+
+            step.kind = NUM_NODE;
+            if (left->status != ARITH_OK) {
+                step.status = left->status;
+            } else if (right->status != ARITH_OK) {
+                step.status = right->status;
+            } else {
+                step.status = checked_apply(ast, node, left->value, right->value, &step.value);
+            }
+            step.left = NO_NODE;
+            step.right = NO_NODE;
+            batch->count -= 2;
+        }
+        *top++ = batch->count;
+        add_step(batch, &step);
+    }
+
+    free(batch->registers);
+    free(batch->operands);
+    batch->registers = malloc((size_t) batch->count * BATCH_ROWS * sizeof(long long));
+    batch->operands = malloc(batch->count * sizeof(long long *));
+    if (batch->registers == NULL || batch->operands == NULL) {
+        fprintf(stderr, "ERROR: out of memory for the steps of an expression\n");
+        exit(1);
+    }
+    for (i = 0; i < batch->count; i++) {
+        long long *block = batch->registers + (size_t) i * BATCH_ROWS;
+
+        batch->operands[i] = block;
+        if (batch->steps[i].kind == NUM_NODE) {
+            for (j = 0; j < BATCH_ROWS; j++) {
+                block[j] = batch->steps[i].value;
+            }
+        }
+    }
+}
+
+/**
+ * Runs one operator over a block of rows. Overflow is rare, so adding,
+ * subtracting and multiplying only note whether any row overflowed, and
+ * look for the rows that did in a second pass when one has.
+ *
+ * @param kind the operator
+ * @param a the left operand of each row
+ * @param b the right operand of each row
+ * @param out where the value of each row is stored
+ * @param status the error of each row, ARITH_OK for none
+ * @param rows the number of rows
+ */
+static void run_step(enum node_kind kind, const long long *restrict a, const long long *restrict b,
+                     long long *restrict out, unsigned char *restrict status, int rows) {
+    long long signs = 0; // the sign bit is set if a row overflowed
+    int failed = 0;
+    int i;
+
+    switch (kind) {
+    case ADD_NODE:
+        for (i = 0; i < rows; i++) {
+            long long sum = (long long) ((unsigned long long) a[i] + (unsigned long long) b[i]);
+
+            out[i] = sum;
+            signs |= (a[i] ^ sum) & (b[i] ^ sum);
+        }
+        if (signs < 0) {
+            for (i = 0; i < rows; i++) {
+                FAIL(i, ((a[i] ^ out[i]) & (b[i] ^ out[i])) < 0, ARITH_OVERFLOW);
+            }
+        }
+        break;
+    case SUB_NODE:
+        for (i = 0; i < rows; i++) {
+            long long difference = (long long) ((unsigned long long) a[i] - (unsigned long long) b[i]);
+
+            out[i] = difference;
+            signs |= (a[i] ^ b[i]) & (a[i] ^ difference);
+        }
+        if (signs < 0) {
+            for (i = 0; i < rows; i++) {
+                FAIL(i, ((a[i] ^ b[i]) & (a[i] ^ out[i])) < 0, ARITH_OVERFLOW);
+            }
+        }
+        break;
+    case MULT_NODE:
+        for (i = 0; i < rows; i++) {
+            failed |= mul_overflows(a[i], b[i], &out[i]);
+        }
+        if (failed) {
+            for (i = 0; i < rows; i++) {
+                long long product;
+
+                FAIL(i, mul_overflows(a[i], b[i], &product), ARITH_OVERFLOW);
+            }
+        }
+        break;
+    case DIV_NODE:
+        for (i = 0; i < rows; i++) {
+            int overflow = a[i] == LLONG_MIN && b[i] == -1;
+
+            out[i] = b[i] == 0 || overflow ? 0 : a[i] / b[i];
+            FAIL(i, b[i] == 0, ARITH_DIVIDE_BY_ZERO);
+            FAIL(i, overflow, ARITH_OVERFLOW);
+        }
+        break;
+    case EXPON_NODE:
+        for (i = 0; i < rows; i++) {
+            int error;
+
+            out[i] = 0;
+            error = checked_pow(a[i], b[i], &out[i]);
+            FAIL(i, error != ARITH_OK, error);
+        }
+        break;
+    case LESS_THEN_NODE:
+        for (i = 0; i < rows; i++) {
+            out[i] = a[i] < b[i];
+        }
+        break;
+    case LESS_THEN_OR_EQUAL_NODE:
+        for (i = 0; i < rows; i++) {
+            out[i] = a[i] <= b[i];
+        }
+        break;
+    case GREATER_THEN_NODE:
+        for (i = 0; i < rows; i++) {
+            out[i] = a[i] > b[i];
+        }
+        break;
+    case GREATER_THEN_OR_EQUAL_NODE:
+        for (i = 0; i < rows; i++) {
+            out[i] = a[i] >= b[i];
+        }
+        break;
+    case EQUALS_NODE:
+        for (i = 0; i < rows; i++) {
+            out[i] = a[i] == b[i];
+        }
+        break;
+    case NOT_EQUALS_NODE:
+        for (i = 0; i < rows; i++) {
+            out[i] = a[i] != b[i];
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Evaluates a compiled expression over some rows of a table.
+ *
+ * @param batch the batch
+ * @param table the columns its variables read
+ * @param start the first row
+ * @param rows the number of rows, at most BATCH_ROWS
+ * @param values where the value of each row is stored
+ * @param status where the error of each row is stored, ARITH_OK for none
+ */
+void batch_run(batch_t *batch, const table_t *table, long start, int rows,
+               long long *values, unsigned char *status) {
+    int i;
+    int j;
+
+    memset(status, ARITH_OK, rows);
+    for (i = 0; i < batch->count; i++) {
+        step_t *step = &batch->steps[i];
+
+        if (step->kind == VARIABLE_NODE) {
+            batch->operands[i] = table->columns[step->column] + start;
+        } else if (step->kind == NUM_NODE) {
+            if (step->status != ARITH_OK) {
+                for (j = 0; j < rows; j++) {
+                    FAIL(j, 1, step->status);
+                }
+            }
+        } else {
+            run_step(step->kind, batch->operands[step->left], batch->operands[step->right],
+                     batch->registers + (size_t) i * BATCH_ROWS, status, rows);
+        }
+    }
+    memcpy(values, batch->operands[batch->count - 1], rows * sizeof(long long));
+}
+
+/**
+ * Parses the expression of -x, which may leave out its ';', and compiles
+ * it. Errors are written as the interpreter would write them for a line,
+ * then the program stops.
+ *
+ * @param worker the worker whose tree and variables are used
+ * @param expression the expression
+ * @param batch the batch it is compiled into
+ */
+static void compile_expression(worker_t *worker, const char *expression, batch_t *batch) {
+    context_t *ctx = &worker->ctx;
+    output_t *out = ctx->out;
+    size_t length = strlen(expression);
+    char *text = malloc(length + 2);
+    output_t messages;
+    token_t token;
+    int root;
+
+    if (text == NULL) {
+        fprintf(stderr, "ERROR: out of memory for the expression\n");
+        exit(1);
+    }
+    memcpy(text, expression, length + 1);
+    while (length > 0 && (text[length - 1] == ' ' || text[length - 1] == '\t'
+                          || text[length - 1] == '\n')) {
+        length--;
+    }
+    if (length == 0 || text[length - 1] != ';') {
+        text[length++] = ';';
+    }
+    text[length] = '\0';
+
+    output_memory(&messages);
+    ctx->out = &messages;
+    ctx->line = text;
+    ctx->line_index = 0;
+    ctx->reported = 0;
+    arena_reset(&worker->arena);
+    ast_reset(&worker->ast);
+
+    get_token(ctx, &token);
+    if (worker->iterative) {
+        root = parse_iterative(ctx, &worker->ast, &worker->stack, &token);
+    } else {
+        root = parse_bexpr(ctx, &worker->ast, &token);
+    }
+    if (root == NO_NODE || token.kind != SEMI_COLON || !at_line_end(ctx)) {
+        if (ctx->syntax_error && !ctx->reported) {
+            output_string(&messages, "===> '");
+            output_string(&messages, ctx->lex_error);
+            output_string(&messages, "' expected\nSyntax Error\n");
+        }
+        fwrite(messages.data, 1, messages.size, stderr);
+        fprintf(stderr, "ERROR: -x takes one statement over the columns, not \"%s\"\n", expression);
+        exit(1);
+    }
+    if (worker->dump) {
+        ast_dump(&messages, &worker->ast, root);
+        fwrite(messages.data, 1, messages.size, stderr);
+    }
+
+    //the literals are read from the text, so it has to outlive compiling
+    batch_compile(batch, &worker->ast, root);
+    ctx->out = out;
+    free(messages.data);
+    free(text);
+}
+
+/**
+ * Writes the values of the rows as CSV: the name of the result, then
+ * the value of each row or the error it stopped at.
+ */
+static void write_csv(output_t *out, const char *name, int name_length,
+                      const long long *values, const unsigned char *status, long rows) {
+    long i;
+
+    output_write(out, name, name_length);
+    output_string(out, "\n");
+    for (i = 0; i < rows; i++) {
+        if (status[i] != ARITH_OK) {
+            output_string(out, arith_message(status[i]));
+        } else {
+            output_long(out, values[i]);
+        }
+        output_string(out, "\n");
+    }
+}
+
+/**
+ * Writes the values of the rows as a binary column file with two
+ * columns: the result, and the error of each row with ARITH_OK for none.
+ */
+static void write_binary(output_t *out, const char *name, int name_length,
+                         const long long *values, const unsigned char *status, long rows) {
+    static const char zeros[8];
+    column_header_t header;
+    long long codes[BATCH_ROWS];
+    uint32_t length = name_length;
+    size_t size = sizeof(column_header_t);
+    long i;
+    int j;
+
+    memset(&header, 0, sizeof(column_header_t));
+    memcpy(header.magic, COLUMN_MAGIC, 4);
+    header.version = COLUMN_VERSION;
+    header.columns = 2;
+    header.rows = rows;
+    output_write(out, (const char *) &header, sizeof(column_header_t));
+
+    output_write(out, (const char *) &length, sizeof(uint32_t));
+    output_write(out, name, length);
+    length = strlen("status");
+    output_write(out, (const char *) &length, sizeof(uint32_t));
+    output_write(out, "status", length);
+    size += 2 * sizeof(uint32_t) + name_length + length;
+    output_write(out, zeros, -size & 7);
+
+    output_write(out, (const char *) values, rows * sizeof(long long));
+    for (i = 0; i < rows; i += BATCH_ROWS) {
+        int count = rows - i < BATCH_ROWS ? rows - i : BATCH_ROWS;
+
+        for (j = 0; j < count; j++) {
+            codes[j] = status[i + j];
+        }
+        output_write(out, (const char *) codes, count * sizeof(long long));
+    }
+}
+
+/**
+ * Evaluates an expression over every row of a table of columns and
+ * writes a column of results. The names in the expression are those of
+ * the columns; an assignment names the result, which is otherwise called
+ * value. Values are 64 bits and checked, whatever -e and -a say.
+ *
+ * @param worker the worker that parses the expression with its options
+ * @param expression the expression
+ * @param input the table, as CSV or a binary column file
+ * @param out where the column of results is written, in the same format
+ * @param path the name of the input, for errors
+ */
+void run_columns(worker_t *worker, const char *expression, input_t *input, output_t *out,
+                 const char *path) {
+    symbols_t *symbols = &worker->symbols;
+    table_t table;
+    batch_t batch;
+    long long *values;
+    unsigned char *status;
+    const char *name = "value";
+    int name_length = strlen(name);
+    long row;
+    int i;
+
+    table_read(&table, input, path);
+    for (i = 0; i < table.count; i++) {
+        if (symbols_intern(symbols, table.names[i], strlen(table.names[i])) != i) {
+            fprintf(stderr, "ERROR: %s has two columns named %s\n", path, table.names[i]);
+            exit(1);
+        }
+        symbols->defined[i] = 1;
+    }
+
+    batch_init(&batch);
+    compile_expression(worker, expression, &batch);
+    if (worker->ctx.target != NO_SLOT) {
+        name = symbols_name(symbols, worker->ctx.target, &name_length);
+    }
+
+    values = malloc((table.rows ? table.rows : 1) * sizeof(long long));
+    status = malloc(table.rows ? table.rows : 1);
+    if (values == NULL || status == NULL) {
+        fprintf(stderr, "ERROR: out of memory for %ld results\n", table.rows);
+        exit(1);
+    }
+    for (row = 0; row < table.rows; row += BATCH_ROWS) {
+        int rows = table.rows - row < BATCH_ROWS ? table.rows - row : BATCH_ROWS;
+
+        batch_run(&batch, &table, row, rows, values + row, status + row);
+    }
+
+    if (table.binary) {
+        write_binary(out, name, name_length, values, status, table.rows);
+    } else {
+        write_csv(out, name, name_length, values, status, table.rows);
+    }
+
+    free(values);
+    free(status);
+    batch_free(&batch);
+    table_free(&table);
+}
@@ -0,0 +1,71 @@
+#ifndef COLUMN_H
+   #define COLUMN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define COLUMN_MAGIC "ICOL"  // first bytes of a binary column file
+#define COLUMN_VERSION 1
+#define BATCH_ROWS 1024      // rows each operator runs over at a time
+
+/*
+ * The start of a binary column file, in the byte order of the machine
+ * that wrote it. The name of each column follows, as a uint32_t length
+ * and its bytes, then zeros up to a multiple of 8 bytes, then the values:
+ * rows int64_t of the first column, then rows of the next, and so on.
+ */
+typedef struct column_header {
+    char magic[4];
+    uint32_t version;
+    uint32_t columns;
+    uint32_t padding;
+    uint64_t rows;
+} column_header_t;
+
+/*
+ * Columns of 64-bit values that all have the same number of rows. Those
+ * of a binary file point into its mapping, those of a CSV file are read
+ * into arrays of their own.
+ */
+typedef struct table {
+    int count;
+    long rows;
+    char **names;                // '\0' terminated
+    const long long **columns;
+    int binary;                  // 1 if the columns came from a binary file
+} table_t;
+
+/* one node of an expression, run over a block of rows at a time */
+typedef struct step {
+    enum node_kind kind;  // NUM_NODE for a part of the tree without variables
+    int left;             // the steps of the operands, which come before it
+    int right;
+    int column;           // the column of a VARIABLE_NODE
+    long long value;      // the value of a NUM_NODE
+    int status;           // ARITH_OK, or the error every row of a NUM_NODE has
+} step_t;
+
+/* an expression compiled to steps, and a block of values for each */
+typedef struct batch {
+    step_t *steps;               // in the order ast_eval_checked evaluates them
+    int count;
+    int capacity;
+    long long *registers;        // BATCH_ROWS values for each step
+    const long long **operands;  // the values of each step in the current block
+} batch_t;
+
+/*
+ * Purpose: Function Prototypes for column.c
+ * Date:    October 17, 2026
+ */
+void table_init(table_t *table);
+void table_free(table_t *table);
+void table_read(table_t *table, input_t *input, const char *path);
+void batch_init(batch_t *batch);
+void batch_free(batch_t *batch);
+void batch_compile(batch_t *batch, ast_t *ast, int root);
+void batch_run(batch_t *batch, const table_t *table, long start, int rows,
+               long long *values, unsigned char *status);
+
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef CONTEXT_H
+   #define CONTEXT_H
+
+/*
+ * Everything the tokenizer and parser need to work through a line.
+ * Each thread uses its own context, so nothing here is shared.
+ */
+typedef struct context {
+    const char *line;       // the current line, which ends at its '\n' or a '\0'
+    int line_index;         // index of where we are in the line
+    int in_lex_error;       // 1 while get_token is collecting a lexical error
+    char lex_error[OPSIZE]; // the lexeme a syntax error expected
+    int syntax_error;       // 1 if the current statement has a syntax error
+    int failed;             // 1 if the current statement has no value
+    int reported;           // 1 once an error of the current statement has been written
+    int status;             // ARITH_OK, or the arithmetic error of the current
+                            // statement in the parser's int arithmetic
+    int target;             // slot the current statement assigns, NO_SLOT if none
+    int stateful;           // 1 once the line has used a variable, so what it
+                            // writes depends on the lines before it
+    struct symbols *symbols; // the variables, which outlive the line
+    output_t *out;          // where diagnostics are written
+    struct arena *arena;    // memory that lasts until the next line
+    struct stats *stats;    // what --stats counts, NULL when it is off
+} context_t;
+
+
+#endif
@@ -0,0 +1,193 @@
+/**
+ * input.c - hands out the lines of the input file without copying them.
+ *
+ * A regular file is mapped into memory once and every line is a span of
+ * the mapping, so there is no limit on the length of a line and no libc
+ * call per line. Pipes and other files that cannot be mapped fall back to
+ * reading chunks into a buffer.
+ *
+ * Every line handed out ends with its '\n', or is followed by a '\0' when
+ * it is the last line and has none, so the tokenizer can always stop on
+ * the byte after the line.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "./Input.h"
+
+
+/**
+ * Opens a file for reading, mapping it when it is a regular file.
+ *
+ * @param input the input to set up
+ * @param path the file to open
+ * @return 1 if successful, 0 if the file could not be opened
+ */
+int input_open(input_t *input, const char *path) {
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return 0;
+    }
+    if (!input_fd(input, fd)) {
+        close(fd);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Reads from a file descriptor that is already open, such as standard
+ * input, mapping it when it is a regular file.
+ *
+ * @param input the input to set up
+ * @param fd the file descriptor to read from
+ * @return 1 if successful, 0 if there is no memory for the read buffer
+ */
+int input_fd(input_t *input, int fd) {
+    struct stat info;
+
+    memset(input, 0, sizeof(input_t));
+    input->fd = fd;
+
+    if (fstat(input->fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void *map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, input->fd, 0);
+        if (map != MAP_FAILED) {
+            madvise(map, info.st_size, MADV_SEQUENTIAL);
+            input->mapped = 1;
+            input->data = map;
+            input->size = info.st_size;
+            input->eof = 1;
+            return 1;
+        }
+    }
+
+    //fall back to reading the file as a stream
+    input->capacity = CHUNK;
+    input->data = malloc(input->capacity);
+    return input->data != NULL;
+}
+
+/**
+ * Reads the next chunk of a streamed input, first moving the unread
+ * bytes to the front of the buffer and growing it if a line fills it.
+ *
+ * @param input the input
+ */
+static void fill(input_t *input) {
+    ssize_t count;
+
+    if (input->pos > 0) {
+        memmove(input->data, input->data + input->pos, input->size - input->pos);
+        input->size -= input->pos;
+        input->pos = 0;
+    }
+
+    //keep room for the '\0' after a last line without a newline
+    if (input->capacity - input->size < CHUNK / 2 + 1) {
+        input->capacity *= 2;
+        input->data = realloc(input->data, input->capacity);
+        if (input->data == NULL) {
+            fprintf(stderr, "ERROR: out of memory for a line of input\n");
+            exit(1);
+        }
+    }
+
+    do {
+        count = read(input->fd, input->data + input->size, input->capacity - input->size - 1);
+    } while (count < 0 && errno == EINTR);
+
+    if (count <= 0) {
+        input->eof = 1;
+    } else {
+        input->size += count;
+    }
+}
+
+/**
+ * Finds the next line of the input.
+ *
+ * @param input the input
+ * @param start set to the first byte of the line
+ * @param length set to the number of bytes in the line, including its '\n'
+ * @return 1 if there was a line, 0 at the end of the input
+ */
+int input_next_line(input_t *input, const char **start, size_t *length) {
+    char *newline;
+    size_t scanned = 0; // bytes of the line already searched for '\n'
+
+    for (;;) {
+        newline = memchr(input->data + input->pos + scanned, '\n', input->size - input->pos - scanned);
+        if (newline != NULL || input->eof) {
+            break;
+        }
+        scanned = input->size - input->pos;
+        fill(input);
+    }
+
+    if (newline != NULL) {
+        *start = input->data + input->pos;
+        *length = newline + 1 - *start;
+        input->pos += *length;
+        return 1;
+    }
+
+    //the last line has no newline
+    if (input->pos == input->size) {
+        return 0;
+    }
+    *length = input->size - input->pos;
+    if (input->mapped) {
+        //the byte after the mapping may not be readable, so copy it
+        free(input->last);
+        input->last = malloc(*length + 1);
+        if (input->last == NULL) {
+            fprintf(stderr, "ERROR: out of memory for a line of input\n");
+            exit(1);
+        }
+        memcpy(input->last, input->data + input->pos, *length);
+        input->last[*length] = '\0';
+        *start = input->last;
+    } else {
+        input->data[input->size] = '\0';
+        *start = input->data + input->pos;
+    }
+    input->pos = input->size;
+    return 1;
+}
+
+/**
+ * Tells whether the next line can be handed out without reading, so a
+ * caller that streams can write out what it has before read may block.
+ *
+ * @param input the input
+ * @return 1 if a whole line is buffered or the input has ended
+ */
+int input_ready(input_t *input) {
+    return input->eof
+        || memchr(input->data + input->pos, '\n', input->size - input->pos) != NULL;
+}
+
+/**
+ * Unmaps or frees the input and closes the file.
+ *
+ * @param input the input
+ */
+void input_close(input_t *input) {
+    if (input->mapped) {
+        munmap(input->data, input->size);
+    } else {
+        free(input->data);
+    }
+    free(input->last);
+    close(input->fd);
+}
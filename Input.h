@@ -0,0 +1,35 @@
+#ifndef INPUT_H
+   #define INPUT_H
+
+#include <stddef.h>
+
+#define CHUNK 65536 // bytes read at a time when the input cannot be mapped
+
+/*
+ * The input file. Regular files are mapped whole, anything else (pipes,
+ * terminals, /dev/stdin) is read in chunks into a buffer that only has to
+ * hold the line being handed out.
+ */
+typedef struct input {
+    int fd;
+    int mapped;       // 1 if data is a mapping of the whole file
+    char *data;       // the mapping, or the read buffer
+    size_t size;      // bytes of data that are valid
+    size_t capacity;  // size of the read buffer
+    size_t pos;       // start of the next line in data
+    int eof;          // 1 once read has returned 0
+    char *last;       // copy of a mapped last line that has no newline
+} input_t;
+
+/*
+ * Purpose: Function Prototypes for input.c
+ * Date:    October 17, 2026
+ */
+int input_open(input_t *input, const char *path);
+int input_fd(input_t *input, int fd);
+int input_ready(input_t *input);
+int input_next_line(input_t *input, const char **start, size_t *length);
+void input_close(input_t *input);
+
+
+#endif
@@ -2,11 +2,39 @@
  *  interpreter.c main controller for a recursive decent parser in parser.c
  *  Date: April 21, 2023
  */
-#include "tokenizer.h"
+#include "Library.h"
 
-#include "parser.h"
+#include "Tokenizer.h"
 
-#include "interpreter.h"
+#include "Output.h"
+
+#include "Context.h"
+
+#include "Parser.h"
+
+#include "Ast.h"
+
+#include "Big.h"
+
+#include "Arith.h"
+
+#include "Vm.h"
+
+#include "Iterative.h"
+
+#include "Cache.h"
+
+#include "Arena.h"
+
+#include "Stats.h"
+
+#include "Input.h"
+
+#include "Symbols.h"
+
+#include "Result.h"
+
+#include "Interpreter.h"
 
 #include <stdio.h>
 
@@ -14,19 +42,45 @@
 
 #include <string.h>
 
-#include <ctype.h>
+#define MAX_THREADS 256
 
-#include <math.h>
+/* when the output is written while lines are still coming in */
+enum flush {
+    FULL_FLUSH,  // when the buffer fills up and at the end
+    BLOCK_FLUSH, // also before waiting for more input
+    LINE_FLUSH   // also after every line
+};
 
-#define ERROR -999999
 
+/**
+ * Prints how to run the program and exits
+ */
+static void usage(void) {
+    printf("Usage: interpreter [-e direct|ast|vm] [-a int|checked|big] [-j threads] [-p recursive|iterative] [-l depth] [-O] [-d] [-c megabytes] [-C cacheFile] [-f line|block|full] [--stats] [-b] [-w] [-x expression] [-s socket | inputFile outputFile]\n");
+    exit(1);
+}
+
+
+/**
+ * Hands out the next line of the input, timing it for --stats
+ * @param worker the worker that runs the lines
+ * @param input the input
+ * @param line set to the first byte of the line
+ * @param length set to the number of bytes in the line, with its '\n'
+ * @return 1 if there was a line, 0 at the end of the input
+ */
+static int next_line(worker_t * worker, input_t * input, const char ** line, size_t * length) {
+    uint64_t start;
+    int more;
 
-extern char * line;
-int line_index;
-extern char curr_cat[OPSIZE];
-extern char lex_error[OPSIZE];
-extern int syntax_error;
-FILE * out_file = NULL;
+    if (worker->ctx.stats == NULL) {
+        return input_next_line(input, line, length);
+    }
+    start = stats_clock();
+    more = input_next_line(input, line, length);
+    worker->stats.read += stats_clock() - start;
+    return more;
+}
 
 
 /**
@@ -37,59 +91,240 @@ FILE * out_file = NULL;
  */
 int main(int argc, char
     const * argv[]) {
-    char token[TSIZE]; /* Spot to hold a token, fixed size */
-    char input_line[LINE]; /* Line of input, fixed size        */
-    FILE * in_file = NULL; /* File pointer                     */
+    enum engine engine = DIRECT_ENGINE;
+    enum arith arith = INT_ARITH;
+    int threads = 1;
+    int iterative = 0;     /* 1 to parse without recursion      */
+    int max_depth = MAX_DEPTH; /* deepest the iterative parser goes */
+    const char * cache_file = NULL; /* results of the last run */
+    const char * socket_path = NULL; /* where to serve clients */
+    const char * expression = NULL; /* run over columns instead of lines */
+    long cache_megabytes = 0; /* 0 to run every line             */
+    int optimize = 0;      /* 1 to simplify each tree before it runs */
+    int dump = 0;          /* 1 to print each tree                  */
+    int flush = -1;        /* enum flush, -1 until it is given      */
+    int stats = 0;         /* 1 to print counters and timings at the end */
+    int watch = 0;         /* 1 to run the input again whenever it changes */
+    int binary = 0;        /* 1 to write a record per statement instead of text */
+    results_t results;     /* The result file of -b              */
+    const char * input_path = "-";  /* "-" for standard input   */
+    const char * output_path = "-"; /* "-" for standard output  */
+    worker_t worker;       /* Runs the lines without threads   */
+    input_t input;         /* The whole input file             */
+    const char * line;     /* The current line                 */
+    size_t line_length;    /* Bytes in the line, with its '\n' */
+    output_t output;       /* Buffer for the output file       */
+    int arg = 1;           /* First argument that is not an option */
 
-    if (argc != 3) {
-        printf("Usage: interpreter inputFile outputFile\n");
-        exit(1);
+    while (arg < argc && argv[arg][0] == '-' && argv[arg][1] != '\0') {
+        if (strcmp(argv[arg], "-e") == 0 && arg + 1 < argc) {
+            if (strcmp(argv[arg + 1], "direct") == 0) {
+                engine = DIRECT_ENGINE;
+            } else if (strcmp(argv[arg + 1], "ast") == 0) {
+                engine = AST_ENGINE;
+            } else if (strcmp(argv[arg + 1], "vm") == 0) {
+                engine = VM_ENGINE;
+            } else {
+                usage();
+            }
+            arg += 2;
+        } else if (strcmp(argv[arg], "-a") == 0 && arg + 1 < argc) {
+            if (strcmp(argv[arg + 1], "int") == 0) {
+                arith = INT_ARITH;
+            } else if (strcmp(argv[arg + 1], "checked") == 0) {
+                arith = CHECKED_ARITH;
+            } else if (strcmp(argv[arg + 1], "big") == 0) {
+                arith = BIG_ARITH;
+            } else {
+                usage();
+            }
+            arg += 2;
+        } else if (strcmp(argv[arg], "-j") == 0 && arg + 1 < argc) {
+            threads = atoi(argv[arg + 1]);
+            if (threads < 1 || threads > MAX_THREADS) {
+                usage();
+            }
+            arg += 2;
+        } else if (strcmp(argv[arg], "-p") == 0 && arg + 1 < argc) {
+            if (strcmp(argv[arg + 1], "recursive") == 0) {
+                iterative = 0;
+            } else if (strcmp(argv[arg + 1], "iterative") == 0) {
+                iterative = 1;
+            } else {
+                usage();
+            }
+            arg += 2;
+        } else if (strcmp(argv[arg], "-l") == 0 && arg + 1 < argc) {
+            max_depth = atoi(argv[arg + 1]);
+            if (max_depth < 1) {
+                usage();
+            }
+            arg += 2;
+        } else if (strcmp(argv[arg], "-c") == 0 && arg + 1 < argc) {
+            cache_megabytes = atol(argv[arg + 1]);
+            if (cache_megabytes < 1) {
+                usage();
+            }
+            arg += 2;
+        } else if (strcmp(argv[arg], "-C") == 0 && arg + 1 < argc) {
+            cache_file = argv[arg + 1];
+            arg += 2;
+        } else if (strcmp(argv[arg], "-f") == 0 && arg + 1 < argc) {
+            if (strcmp(argv[arg + 1], "line") == 0) {
+                flush = LINE_FLUSH;
+            } else if (strcmp(argv[arg + 1], "block") == 0) {
+                flush = BLOCK_FLUSH;
+            } else if (strcmp(argv[arg + 1], "full") == 0) {
+                flush = FULL_FLUSH;
+            } else {
+                usage();
+            }
+            arg += 2;
+        } else if (strcmp(argv[arg], "-s") == 0 && arg + 1 < argc) {
+            socket_path = argv[arg + 1];
+            arg += 2;
+        } else if (strcmp(argv[arg], "-b") == 0) {
+            binary = 1;
+            arg++;
+        } else if (strcmp(argv[arg], "-w") == 0) {
+            watch = 1;
+            arg++;
+        } else if (strcmp(argv[arg], "-x") == 0 && arg + 1 < argc) {
+            expression = argv[arg + 1];
+            arg += 2;
+        } else if (strcmp(argv[arg], "--stats") == 0) {
+            stats = 1;
+            arg++;
+        } else if (strcmp(argv[arg], "-O") == 0) {
+            optimize = 1;
+            arg++;
+        } else if (strcmp(argv[arg], "-d") == 0) {
+            dump = 1;
+            arg++;
+        } else {
+            usage();
+        }
     }
 
-    in_file = fopen(argv[1], "r");
-    if (in_file == NULL) {
-        fprintf(stderr, "ERROR: could not open %s for reading\n", argv[1]);
-        exit(1);
+    if ((argc - arg != 2 && argc - arg != 0) || (cache_file != NULL && threads > 1)) {
+        usage();
     }
-
-    out_file = fopen(argv[2], "w");
-    if (out_file == NULL) {
-        fprintf(stderr, "ERROR: could not open %s for writing\n", argv[2]);
-        exit(1);
+    // only the loop of one thread can flush as lines come in
+    if (flush > FULL_FLUSH && (threads > 1 || cache_file != NULL)) {
+        usage();
+    }
+    // a server answers its clients instead of reading files
+    if (socket_path != NULL
+        && (argc - arg != 0 || threads > 1 || cache_file != NULL || flush >= 0)) {
+        usage();
     }
 
+    // columns are one statement run over every row, not lines
+    if (expression != NULL
+        && (socket_path != NULL || threads > 1 || cache_file != NULL || cache_megabytes > 0
+            || flush >= 0 || stats)) {
+        usage();
+    }
 
-    while (fgets(input_line, LINE, in_file) != NULL) {
-        // Sets a global pointer to the memory location
-        // where the input line resides.
-        line = input_line;
-        line_index = 0;
+    // watching keeps the whole output and rewrites parts of a real file
+    if (watch
+        && (argc - arg != 2 || strcmp(argv[arg], "-") == 0 || strcmp(argv[arg + 1], "-") == 0
+            || socket_path != NULL || expression != NULL || threads > 1 || cache_file != NULL
+            || flush >= 0)) {
+        usage();
+    }
 
-        fprintf(out_file, "%s", line);
+    // records are written by one worker that runs every line, in order
+    if (binary
+        && (socket_path != NULL || expression != NULL || watch || threads > 1 || cache_file != NULL
+            || cache_megabytes > 0 || dump)) {
+        usage();
+    }
 
-        //goes all the way to the end of the line
-        while (line[line_index] != '\0' &&
-            line[line_index] != '\n') {
-            int result;
+    worker_init(&worker, engine, &output);
+    worker.arith = arith;
+    worker.iterative = iterative;
+    worker.stack.max_depth = max_depth;
+    worker.optimize = optimize;
+    worker.dump = dump;
+    if (cache_megabytes > 0) {
+        worker_cache(&worker, (size_t) cache_megabytes * 1048576);
+    }
+    if (stats) {
+        worker_stats(&worker);
+    }
+    if (socket_path != NULL) {
+        run_server(&worker, socket_path);
+        if (cache_megabytes > 0) {
+            fprintf(stderr, "Cache: %ld hits, %ld misses\n", worker.cache.hits, worker.cache.misses);
+        }
+        if (stats) {
+            stats_report(stderr, &worker.stats, worker.statements, worker.errors, 0);
+        }
+        worker_free(&worker);
+        return 0;
+    }
 
-            get_token(token);
+    if (argc - arg == 2) {
+        input_path = argv[arg];
+        output_path = argv[arg + 1];
+    }
 
-            result = bexpr(token);
-            if (result != ERROR) {
-            fprintf(out_file, "Syntax OK\nValue is %d\n", result);
-            } else {
-                while(get_token(token));
-                if(syntax_error && strcmp(token, ";") != 0) {
-                    fprintf(out_file, "===> '%s' expected\nSyntax Error\n", lex_error);
-                }
-                break;
-            }
+    if (strcmp(input_path, "-") == 0 ? !input_fd(&input, 0) : !input_open(&input, input_path)) {
+        fprintf(stderr, "ERROR: could not open %s for reading\n", input_path);
+        exit(1);
+    }
 
+    if (strcmp(output_path, "-") == 0) {
+        output_fd(&output, 1);
+        // a pipe reading the results should not wait on a full buffer
+        if (flush < 0 && threads == 1 && cache_file == NULL) {
+            flush = BLOCK_FLUSH;
         }
+    } else if (!output_open(&output, output_path)) {
+        fprintf(stderr, "ERROR: could not open %s for writing\n", output_path);
+        exit(1);
+    }
+    // echoed lines can be written straight from the mapped input
+    output.borrow = input.mapped;
 
+    // diagnostics become the messages of the records
+    if (binary) {
+        results_init(&results, &output);
+        worker.results = &results;
+        worker.ctx.out = &results.messages;
+    }
+
+    if (watch) {
+        run_watch(&worker, &output, input_path);
+    } else if (expression != NULL) {
+        run_columns(&worker, expression, &input, &output, input_path);
+    } else if (cache_file != NULL) {
+        run_cache_file(&worker, &input, &output, cache_file);
+    } else if (threads > 1) {
+        run_parallel(&input, &output, &worker, threads);
+    } else {
+        while (next_line(&worker, &input, &line, &line_length)) {
+            run_line(&worker, line, line_length);
+            if (flush == LINE_FLUSH || (flush == BLOCK_FLUSH && !input_ready(&input))) {
+                output_flush(&output);
+            }
+        }
+    }
+    if (binary) {
+        results_finish(&results);
+    }
+    if (cache_megabytes > 0) {
+        fprintf(stderr, "Cache: %ld hits, %ld misses\n", worker.cache.hits, worker.cache.misses);
+    }
+    if (stats) {
+        output_flush(&output);
+        stats_report(stderr, &worker.stats, worker.statements, worker.errors, output.write_ns);
     }
+    worker_free(&worker);
 
-    fclose(in_file);
-    fclose(out_file);
+    // borrowed lines point into the input, so flush before closing it
+    output_close(&output);
+    input_close(&input);
     return 0;
 }
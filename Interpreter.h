@@ -1,7 +1,49 @@
 #include <stdio.h>
 
-extern char * line;
-extern int line_index;
-extern char curr_cat[OPSIZE];
-extern char lex_error[OPSIZE];
-extern int syntax_error;
+/*
+ * One thread running lines of input: its tokenizer and parser context and
+ * the buffers its engine reuses from one statement to the next.
+ */
+typedef struct worker {
+    context_t ctx;
+    enum engine engine;
+    enum arith arith;
+    ast_t ast;
+    parse_stack_t stack;   // frames of the iterative parser
+    program_t program;
+    registers_t registers; // values of the tree in BIG_ARITH
+    int status;            // how the last statement ended in a wide arith
+    long long wide;        // its value in CHECKED_ARITH
+    int root;              // the root of its tree, and its register in BIG_ARITH
+    int iterative;  // 1 to parse with iterative.c instead of recursion
+    int optimize;   // 1 to simplify each tree with optimize.c before it is evaluated
+    int dump;       // 1 to print each tree after "Syntax OK"
+    cache_t cache;         // lines run before, when max_bytes is set
+    output_t scratch;      // what a line writes while it is being cached
+    arena_t arena;         // memory of the current line, reset as each one starts
+    symbols_t symbols;     // the variables, which keep their values from line to line
+    stats_t stats;         // what --stats counts, when ctx.stats points at it
+    int report;     // 1 to echo each line and print every value to ctx.out
+    int echo;       // 0 to leave the line out when reporting
+    struct results *results; // where -b writes a record per statement, NULL for text
+    int statements; // statements that had a value
+    int errors;     // lines that stopped at an error
+    int arithmetic_errors; // statements that divided by zero or overflowed
+    int value;      // value of the last statement that had one
+} worker_t;
+
+void worker_init(worker_t * worker, enum engine engine, output_t * out);
+void worker_free(worker_t * worker);
+void worker_settings(worker_t * worker, const worker_t * settings);
+void worker_cache(worker_t * worker, size_t max_bytes);
+void worker_stats(worker_t * worker);
+void worker_errors(const worker_t * worker, cache_errors_t * errors);
+void worker_errors_since(const worker_t * worker, cache_errors_t * errors);
+void worker_add_errors(worker_t * worker, const cache_errors_t * errors);
+void run_line(worker_t * worker, const char * line, size_t length);
+void run_cache_file(worker_t * worker, input_t * input, output_t * out, const char * path);
+void run_parallel(input_t * input, output_t * out, worker_t * settings, int threads);
+void run_server(worker_t * settings, const char * path);
+void run_watch(worker_t * worker, output_t * out, const char * path);
+void run_columns(worker_t * worker, const char * expression, input_t * input, output_t * out,
+                 const char * path);
@@ -0,0 +1,262 @@
+/*
+ * iterative.c - builds the same tree as the parse functions of ast.c
+ * without recursion, so a line nested tens of thousands of levels deep
+ * or chaining as many operators cannot run the process out of stack.
+ * Each non-terminal that would call another pushes a frame on a stack
+ * kept on the heap and picks up where it left off once the one it called
+ * has a result. The tails of ast.c become loops, so chained operators do
+ * not grow the stack at all. The tree is walked without recursion after
+ * that, so only the nesting of parentheses is limited, to keep a line
+ * from taking unbounded memory for frames; a statement past the limit is
+ * a syntax error. Diagnostics are the same as ast.c for every statement
+ * within the limit.
+ * Date:   October 17, 2026
+ */
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <string.h>
+
+#include "Tokenizer.h"
+
+#include "Output.h"
+
+#include "Context.h"
+
+#include "Parser.h"
+
+#include "Ast.h"
+
+#include "Iterative.h"
+
+#include "Stats.h"
+
+#include "Symbols.h"
+
+
+/* the non-terminals that call others, in the order they call each other */
+enum level {
+   EXPR_LEVEL,   // <expr> and <ttail>
+   TERM_LEVEL,   // <term> and <stail>
+   STMT_LEVEL,   // <stmt> and <ftail>
+   FACTOR_LEVEL, // <factor>
+   EXPP_LEVEL    // <expp>
+};
+
+/* Node kind of each binary operator token, as in ast.c */
+static const enum node_kind operator_nodes[TOKEN_KINDS] = {
+   [ADD_OP] = ADD_NODE,
+   [SUB_OP] = SUB_NODE,
+   [MULT_OP] = MULT_NODE,
+   [DIV_OP] = DIV_NODE,
+   [LESS_THEN_OP] = LESS_THEN_NODE,
+   [LESS_THEN_OR_EQUAL_OP] = LESS_THEN_OR_EQUAL_NODE,
+   [GREATER_THEN_OP] = GREATER_THEN_NODE,
+   [GREATER_THEN_OR_EQUAL_OP] = GREATER_THEN_OR_EQUAL_NODE,
+   [EQUALS_OP] = EQUALS_NODE,
+   [NOT_EQUALS_OP] = NOT_EQUALS_NODE
+};
+
+/* how far a non-terminal got before it called another */
+enum step {
+   START_STEP,    // nothing parsed yet
+   LEFT_STEP,     // waiting for the left operand, the base or the inner expression
+   RIGHT_STEP     // waiting for the right operand or the exponent
+};
+
+
+/**
+ * Sets up an empty stack
+ * @param stack the stack
+ * @param max_depth deepest nesting of parentheses a statement may have
+ */
+void parse_stack_init(parse_stack_t * stack, int max_depth) {
+   stack->frames = NULL;
+   stack->count = 0;
+   stack->capacity = 0;
+   stack->max_depth = max_depth;
+}
+
+/**
+ * Releases the frames of a stack
+ * @param stack the stack
+ */
+void parse_stack_free(parse_stack_t * stack) {
+   free(stack->frames);
+   stack->frames = NULL;
+   stack->capacity = 0;
+}
+
+/**
+ * Starts a non-terminal on top of the stack
+ * @param stack the stack
+ * @param level the non-terminal
+ */
+static void push(parse_stack_t * stack, int level) {
+   frame_t *frame;
+
+   if (stack->count == stack->capacity) {
+      int capacity = stack->capacity ? stack->capacity * 2 : 64;
+      frame_t *frames = realloc(stack->frames, capacity * sizeof(frame_t));
+
+      if (frames == NULL)
+         out_of_memory("ERROR: out of memory for the parse stack");
+      stack->frames = frames;
+      stack->capacity = capacity;
+   }
+   frame = &stack->frames[stack->count++];
+   frame->level = level;
+   frame->step = START_STEP;
+}
+
+/**
+ * @param level the expr, term or stmt level
+ * @param kind the current token
+ * @return 1 if the token is an operator of that level
+ */
+static int level_operator(int level, enum token_kind kind) {
+   switch (level) {
+   case EXPR_LEVEL:
+      return kind == ADD_OP || kind == SUB_OP;
+   case TERM_LEVEL:
+      return kind == MULT_OP || kind == DIV_OP;
+   default:
+      return kind == LESS_THEN_OP || kind == LESS_THEN_OR_EQUAL_OP
+         || kind == GREATER_THEN_OP || kind == GREATER_THEN_OR_EQUAL_OP
+         || kind == EQUALS_OP || kind == NOT_EQUALS_OP;
+   }
+}
+
+/**
+ * Reports a statement that nests parentheses deeper than the stack allows
+ * @param ctx the line being read and the error state
+ * @param stack the stack
+ * @return NO_NODE
+ */
+static int too_deep(context_t * ctx, parse_stack_t * stack) {
+   if (ctx->stats != NULL)
+      ctx->stats->depth_errors++;
+   output_string(ctx->out, "===> statement deeper than ");
+   output_int(ctx->out, stack->max_depth);
+   output_string(ctx->out, " levels\nSyntax Error\n");
+   ctx->reported = 1;
+   return NO_NODE;
+}
+
+/**
+ * <bexpr> ::= <name> = <expr> ; | <expr> ;
+ * Parses a statement the way parse_bexpr does, with the stack in place
+ * of recursion.
+ * @param ctx the line being read and the error state
+ * @param ast the arena to build the tree in
+ * @param stack the stack to keep the pending non-terminals on
+ * @param token the current lexeme
+ * @return the root of the statement or NO_NODE
+ */
+int parse_iterative(context_t * ctx, ast_t * ast, parse_stack_t * stack, token_t * token) {
+   frame_t *frame;
+   int result = NO_NODE; // what the last non-terminal to finish returned
+   int nesting = 0;      // parentheses open
+
+   ctx->syntax_error = 0;
+   ast->line = ctx->line;
+   ast->symbols = ctx->symbols;
+   assignment(ctx, token);
+   stack->count = 0;
+   push(stack, EXPR_LEVEL);
+
+   while (stack->count > 0) {
+      frame = &stack->frames[stack->count - 1];
+
+      switch (frame->level) {
+      case EXPR_LEVEL:
+      case TERM_LEVEL:
+      case STMT_LEVEL:
+         if (frame->step == START_STEP) {
+            frame->step = LEFT_STEP;
+            push(stack, frame->level + 1);
+            continue;
+         }
+         if (result == NO_NODE) {
+            stack->count--;
+            continue;
+         }
+         if (frame->step == LEFT_STEP)
+            frame->left = result;
+         else
+            frame->left = ast_node(ast, frame->kind, frame->left, result);
+         //the tail: another operator of this level, or done
+         if (level_operator(frame->level, token->kind)) {
+            frame->kind = operator_nodes[token->kind];
+            frame->step = RIGHT_STEP;
+            get_token(ctx, token);
+            push(stack, frame->level + 1);
+         } else {
+            result = frame->left;
+            stack->count--;
+         }
+         break;
+
+      case FACTOR_LEVEL:
+         if (frame->step == START_STEP) {
+            frame->step = LEFT_STEP;
+            push(stack, EXPP_LEVEL);
+         } else if (frame->step == LEFT_STEP) {
+            if (token->kind != EXPON_OP) {
+               stack->count--;
+            } else if (!get_token(ctx, token) || result == NO_NODE) {
+               result = NO_NODE;
+               stack->count--;
+            } else {
+               frame->left = result;
+               frame->step = RIGHT_STEP;
+               push(stack, FACTOR_LEVEL);
+            }
+         } else {
+            if (result != NO_NODE)
+               result = ast_node(ast, EXPON_NODE, frame->left, result);
+            stack->count--;
+         }
+         break;
+
+      case EXPP_LEVEL:
+         if (frame->step == START_STEP) {
+            if (token->kind == IDENTIFIER) {
+               result = parse_name(ctx, ast, token);
+               stack->count--;
+            } else if (token->kind != LEFT_PAREN) {
+               result = parse_num(ctx, ast, token);
+               stack->count--;
+            } else if (!get_token(ctx, token)) {
+               result = NO_NODE;
+               stack->count--;
+            } else {
+               if (++nesting > stack->max_depth)
+                  return too_deep(ctx, stack);
+               frame->step = LEFT_STEP;
+               push(stack, EXPR_LEVEL);
+            }
+         } else {
+            nesting--;
+            if (token->kind != RIGHT_PAREN) {
+               //No closing parenthesis error
+               strcpy(ctx->lex_error, ")");
+               ctx->syntax_error = 1;
+               output_string(ctx->out, "===> ')' expected\nSyntax Error\n");
+               ctx->reported = 1;
+               result = NO_NODE;
+            } else if (!get_token(ctx, token)) {
+               result = NO_NODE;
+            }
+            stack->count--;
+         }
+         break;
+      }
+   }
+
+   //Make sure there is a semicolon
+   if (!statement_end(ctx, token, result != NO_NODE))
+      return NO_NODE;
+   return result;
+}
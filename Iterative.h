@@ -0,0 +1,33 @@
+#ifndef ITERATIVE_H
+   #define ITERATIVE_H
+
+#ifndef MAX_DEPTH
+#define MAX_DEPTH 10000 // default limit on the nesting of parentheses
+#endif
+
+/* a non-terminal of parser.c that is waiting for the one it called, five per ( */
+typedef struct frame {
+   unsigned char level;   // which non-terminal, from the expr level to the expp level
+   unsigned char step;    // how far it got before it called another
+   unsigned char kind;    // the node kind of the operator it is building a node for
+   int left;              // the tree it has built so far
+} frame_t;
+
+/* the frames of the statement being parsed, reused from one statement to the next */
+typedef struct parse_stack {
+   frame_t *frames;
+   int count;
+   int capacity;
+   int max_depth; // deepest nesting of parentheses a statement may have
+} parse_stack_t;
+
+/*
+ * Purpose: Function Prototypes for iterative.c
+ * Date:    October 17, 2026
+ */
+void parse_stack_init(parse_stack_t *, int);
+void parse_stack_free(parse_stack_t *);
+int parse_iterative(context_t *, ast_t *, parse_stack_t *, token_t *);
+
+
+#endif
@@ -0,0 +1,704 @@
+/**
+ * library.c - runs statements for the interpreter program and for
+ * programs that embed the interpreter.
+ * run_line is what interpreter.c and parallel.c use on each line of an
+ * input file. The interp_ functions wrap a worker in a context of its own
+ * and run whole strings and buffers, handing back the values and error
+ * messages instead of writing them to a file.
+ * Date:   October 17, 2026
+ */
+#include "Library.h"
+
+#include "Tokenizer.h"
+
+#include "Output.h"
+
+#include "Context.h"
+
+#include "Parser.h"
+
+#include "Ast.h"
+
+#include "Big.h"
+
+#include "Arith.h"
+
+#include "Vm.h"
+
+#include "Iterative.h"
+
+#include "Cache.h"
+
+#include "Arena.h"
+
+#include "Stats.h"
+
+#include "Optimize.h"
+
+#include "Input.h"
+
+#include "Symbols.h"
+
+#include "Result.h"
+
+#include "Interpreter.h"
+
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <string.h>
+
+#include <setjmp.h>
+
+/* an interpreter for a program that embeds it */
+struct interp_ctx {
+    worker_t worker;
+    output_t diagnostics;  // error messages of the current call
+    char *last;            // copy of a last line that has no end
+    size_t last_capacity;
+};
+
+
+/**
+ * Sets up a worker with an empty context
+ * @param worker the worker
+ * @param engine how the worker evaluates statements
+ * @param out where the worker writes its results
+ */
+void worker_init(worker_t * worker, enum engine engine, output_t * out) {
+    memset(&worker->ctx, 0, sizeof(context_t));
+    worker->ctx.out = out;
+    worker->engine = engine;
+    worker->arith = INT_ARITH;
+    ast_init(&worker->ast);
+    parse_stack_init(&worker->stack, MAX_DEPTH);
+    program_init(&worker->program);
+    registers_init(&worker->registers);
+    worker->iterative = 0;
+    worker->optimize = 0;
+    worker->dump = 0;
+    cache_init(&worker->cache, 0);
+    worker->scratch.data = NULL;
+    arena_init(&worker->arena);
+    worker->ctx.arena = &worker->arena;
+    symbols_init(&worker->symbols);
+    worker->ctx.symbols = &worker->symbols;
+    worker->ctx.target = NO_SLOT;
+    worker->report = 1;
+    worker->echo = 1;
+    worker->results = NULL;
+    worker->statements = 0;
+    worker->errors = 0;
+    worker->arithmetic_errors = 0;
+    worker->value = 0;
+}
+
+/**
+ * Releases the buffers of a worker
+ * @param worker the worker
+ */
+void worker_free(worker_t * worker) {
+    cache_free(&worker->cache);
+    free(worker->scratch.data);
+    arena_free(&worker->arena);
+    symbols_free(&worker->symbols);
+    registers_free(&worker->registers);
+    program_free(&worker->program);
+    parse_stack_free(&worker->stack);
+    ast_free(&worker->ast);
+}
+
+/**
+ * Gives a worker the same options as another, for threads that each run
+ * some of the lines with a worker of their own
+ * @param worker the worker
+ * @param settings the worker to copy the options of
+ */
+void worker_settings(worker_t * worker, const worker_t * settings) {
+    worker->arith = settings->arith;
+    worker->iterative = settings->iterative;
+    worker->stack.max_depth = settings->stack.max_depth;
+    worker->optimize = settings->optimize;
+    worker->dump = settings->dump;
+    if (settings->ctx.stats != NULL) {
+        worker_stats(worker);
+    }
+}
+
+/**
+ * Turns on --stats for a worker: from now on it counts tokens and errors
+ * and times the phases of each line
+ * @param worker the worker
+ */
+void worker_stats(worker_t * worker) {
+    stats_init(&worker->stats);
+    worker->ctx.stats = &worker->stats;
+}
+
+/**
+ * Turns on the cache of a worker, so a line it has run before writes
+ * what it wrote then without being lexed or parsed again
+ * @param worker the worker
+ * @param max_bytes most memory the cached lines may take
+ */
+void worker_cache(worker_t * worker, size_t max_bytes) {
+    if (worker->scratch.data == NULL) {
+        output_memory(&worker->scratch);
+    }
+    worker->cache.max_bytes = max_bytes;
+}
+
+/**
+ * Notes how many errors of each kind a worker has counted so far, so
+ * what a line adds can be kept with it in a cache. Without --stats only
+ * the arithmetic errors are counted, the rest are 0.
+ * @param worker the worker
+ * @param errors set to its counts
+ */
+void worker_errors(const worker_t * worker, cache_errors_t * errors) {
+    const stats_t *stats = worker->ctx.stats;
+
+    memset(errors, 0, sizeof(cache_errors_t));
+    errors->arithmetic = worker->arithmetic_errors;
+    if (stats != NULL) {
+        errors->lexical = stats->lexical_errors;
+        errors->syntax = stats->syntax_errors;
+        errors->name = stats->name_errors;
+        errors->depth = stats->depth_errors;
+    }
+}
+
+/**
+ * Turns counts noted with worker_errors into the errors found since
+ * @param worker the worker
+ * @param errors the counts, set to what was added to them since
+ */
+void worker_errors_since(const worker_t * worker, cache_errors_t * errors) {
+    cache_errors_t now;
+
+    worker_errors(worker, &now);
+    errors->lexical = now.lexical - errors->lexical;
+    errors->syntax = now.syntax - errors->syntax;
+    errors->name = now.name - errors->name;
+    errors->arithmetic = now.arithmetic - errors->arithmetic;
+    errors->depth = now.depth - errors->depth;
+}
+
+/**
+ * Counts the errors of a line found in a cache as if it had been run
+ * @param worker the worker
+ * @param errors the errors of the line by kind
+ */
+void worker_add_errors(worker_t * worker, const cache_errors_t * errors) {
+    stats_t *stats = worker->ctx.stats;
+
+    worker->arithmetic_errors += errors->arithmetic;
+    if (stats != NULL) {
+        stats->lexical_errors += errors->lexical;
+        stats->syntax_errors += errors->syntax;
+        stats->name_errors += errors->name;
+        stats->arithmetic_errors += errors->arithmetic;
+        stats->depth_errors += errors->depth;
+    }
+}
+
+/**
+ * Gives the variable a statement assigned the value the statement had,
+ * in the arithmetic of the worker. A statement that ended in an
+ * arithmetic error has no value, so the variable keeps the one it had.
+ * @param worker the worker
+ * @param result the value of the statement in int arithmetic
+ */
+static void assign(worker_t * worker, int result) {
+    symbols_t *symbols = &worker->symbols;
+    int slot = worker->ctx.target;
+
+    if (worker->status != ARITH_OK) {
+        return;
+    } else if (worker->arith == INT_ARITH) {
+        symbols->values[slot] = result;
+    } else if (worker->arith == CHECKED_ARITH) {
+        symbols->wide[slot] = worker->wide;
+    } else {
+        big_assign(&worker->registers, slot, worker->root);
+    }
+    symbols->defined[slot] = 1;
+}
+
+/**
+ * Parses and evaluates one statement with the engine of the worker.
+ * Wider arithmetic, the iterative parser, optimizing and dumping always
+ * build the tree, whose
+ * root is kept in the worker. Wider arithmetic leaves its value and
+ * status in the worker instead of in result, and is never optimized
+ * since the folding is done in int. Int arithmetic leaves its status
+ * there too, which only a division can make an error. A statement that
+ * assigns a variable stores its value before the next statement is parsed.
+ * @param worker the worker
+ * @param token the first lexeme of the statement
+ * @param result where the value of the statement is stored
+ * @return 1 if the statement has a value, 0 on error
+ */
+static int evaluate(worker_t * worker, token_t * token, int * result) {
+    int root;
+
+    if (worker->engine != DIRECT_ENGINE || worker->arith != INT_ARITH
+        || worker->iterative || worker->optimize || worker->dump) {
+        ast_reset(&worker->ast);
+        if (worker->iterative) {
+            root = parse_iterative(&worker->ctx, &worker->ast, &worker->stack, token);
+        } else {
+            root = parse_bexpr(&worker->ctx, &worker->ast, token);
+        }
+        if (root == NO_NODE) {
+            return 0;
+        }
+        if (worker->optimize && worker->arith == INT_ARITH) {
+            root = optimize(&worker->ast, root);
+        }
+        worker->root = root;
+        if (worker->arith == CHECKED_ARITH) {
+            worker->status = ast_eval_checked(&worker->ast, root, &worker->wide);
+            *result = 0;
+        } else if (worker->arith == BIG_ARITH) {
+            worker->status = ast_eval_big(&worker->registers, &worker->ast, root);
+            *result = 0;
+        } else if (worker->engine == VM_ENGINE) {
+            compile(&worker->program, &worker->ast, root);
+            *result = vm_run(&worker->program);
+            worker->status = worker->program.status;
+        } else {
+            *result = ast_eval(&worker->ast, root);
+            worker->status = worker->ast.status;
+        }
+    } else {
+        *result = bexpr(&worker->ctx, token);
+        if (worker->ctx.failed) {
+            return 0;
+        }
+        worker->status = worker->ctx.status;
+    }
+
+    if (worker->ctx.target != NO_SLOT) {
+        assign(worker, *result);
+    }
+    return 1;
+}
+
+/**
+ * Prints the value of a statement evaluated with wider arithmetic, or
+ * why a statement in any arithmetic has none
+ * @param worker the worker
+ */
+static void report_wide(worker_t * worker) {
+    output_t *out = worker->ctx.out;
+
+    if (worker->status != ARITH_OK) {
+        output_string(out, arith_message(worker->status));
+    } else if (worker->arith == CHECKED_ARITH) {
+        output_string(out, "Value is ");
+        output_long(out, worker->wide);
+    } else {
+        output_string(out, "Value is ");
+        output_big(out, &worker->registers.values[worker->root]);
+    }
+    output_string(out, "\n");
+}
+
+/**
+ * Writes the record of a statement that had a value to the result file
+ * of a worker. A value of -a big too wide for the record is kept as
+ * digits at the end of its message.
+ * @param worker the worker
+ * @param result the value of the statement in int arithmetic
+ */
+static void record(worker_t * worker, int result) {
+    long long value;
+
+    if (worker->status != ARITH_OK) {
+        results_value(worker->results, worker->status, 0);
+    } else if (worker->arith == INT_ARITH) {
+        results_value(worker->results, RESULT_VALUE, result);
+    } else if (worker->arith == CHECKED_ARITH) {
+        results_value(worker->results, RESULT_VALUE, worker->wide);
+    } else if (big_fits(&worker->registers.values[worker->root], &value)) {
+        results_value(worker->results, RESULT_VALUE, value);
+    } else {
+        output_big(&worker->results->messages, &worker->registers.values[worker->root]);
+        results_value(worker->results, RESULT_BIG, 0);
+    }
+}
+
+/**
+ * Runs every statement on the line in the context of a worker
+ * @param worker the worker
+ */
+static void run_statements(worker_t * worker) {
+    context_t *ctx = &worker->ctx;
+    token_t token; /* Spot to hold a token and its category */
+    long lexical = 0, names = 0; /* what --stats had counted as the statement started */
+
+    //goes all the way to the end of the line
+    while (!at_line_end(ctx)) {
+        int result;
+
+        ctx->reported = 0;
+        if (ctx->stats != NULL) {
+            lexical = ctx->stats->lexical_errors;
+            names = ctx->stats->name_errors;
+        }
+        get_token(ctx, &token);
+
+        if (evaluate(worker, &token, &result)) {
+            if (worker->status == ARITH_OK) {
+                worker->statements++;
+                worker->value = result;
+            } else {
+                worker->arithmetic_errors++;
+                if (ctx->stats != NULL) {
+                    ctx->stats->arithmetic_errors++;
+                }
+            }
+            if (worker->results != NULL) {
+                record(worker, result);
+            } else if (worker->report) {
+                output_string(ctx->out, "Syntax OK\n");
+                if (worker->dump) {
+                    ast_dump(ctx->out, &worker->ast, worker->root);
+                }
+                if (worker->arith != INT_ARITH || worker->status != ARITH_OK) {
+                    report_wide(worker);
+                } else {
+                    output_string(ctx->out, "Value is ");
+                    output_int(ctx->out, result);
+                    output_string(ctx->out, "\n");
+                }
+            } else if (worker->status != ARITH_OK) {
+                output_string(ctx->out, arith_message(worker->status));
+                output_string(ctx->out, "\n");
+            }
+        } else {
+            //a statement that did not stop at a lexical or name error
+            //stopped at a syntax error, whichever message it got
+            if (ctx->stats != NULL && ctx->stats->lexical_errors == lexical
+                && ctx->stats->name_errors == names) {
+                ctx->stats->syntax_errors++;
+            }
+            while(get_token(ctx, &token));
+            if(ctx->syntax_error && token.kind != SEMI_COLON) {
+                output_string(ctx->out, "===> '");
+                output_string(ctx->out, ctx->lex_error);
+                output_string(ctx->out, "' expected\nSyntax Error\n");
+            } else if (!ctx->reported) {
+                //nothing said why, as with an operator, ')' or ';' where an operand belongs
+                output_string(ctx->out, "===> operand expected\nSyntax Error\n");
+            }
+            if (worker->results != NULL) {
+                results_error(worker->results);
+            }
+            worker->errors++;
+            break;
+        }
+
+    }
+}
+
+/**
+ * Runs a line through the cache of a worker. Space at either end of the
+ * line never changes what it writes, so it is left out of the key. On a
+ * miss the line writes to the scratch output, which is then copied to the
+ * real one and stored, unless it used a variable: what such a line writes
+ * depends on the lines before it, and it changes what later lines write.
+ * @param worker the worker
+ * @param line the line
+ * @param length the number of bytes in the line, with its '\n'
+ */
+static void run_cached(worker_t * worker, const char * line, size_t length) {
+    context_t *ctx = &worker->ctx;
+    output_t *out = ctx->out;
+    const char *key = line;
+    size_t key_length = length;
+    uint64_t hash;
+    cache_entry_t *entry;
+    int statements = worker->statements;
+    int errors = worker->errors;
+    cache_errors_t by_kind;
+
+    while (key_length > 0 && (*key == ' ' || *key == '\t' || *key == '\r')) {
+        key++;
+        key_length--;
+    }
+    while (key_length > 0 && (key[key_length - 1] == ' ' || key[key_length - 1] == '\t'
+                              || key[key_length - 1] == '\r' || key[key_length - 1] == '\n')) {
+        key_length--;
+    }
+    hash = cache_hash(key, key_length);
+
+    entry = cache_find(&worker->cache, key, key_length, hash);
+    if (entry != NULL) {
+        output_write(out, cache_output(entry), entry->output_length);
+        worker->statements += entry->statements;
+        worker->errors += entry->errors;
+        worker_add_errors(worker, &entry->by_kind);
+        if (entry->statements > 0) {
+            worker->value = entry->value;
+        }
+        return;
+    }
+
+    worker->scratch.size = 0;
+    worker_errors(worker, &by_kind);
+    ctx->out = &worker->scratch;
+    run_statements(worker);
+    ctx->out = out;
+    output_write(out, worker->scratch.data, worker->scratch.size);
+    if (ctx->stateful) {
+        return;
+    }
+    worker_errors_since(worker, &by_kind);
+    cache_store(&worker->cache, key, key_length, hash,
+                worker->scratch.data, worker->scratch.size,
+                worker->statements - statements, worker->errors - errors,
+                &by_kind, worker->value);
+}
+
+/**
+ * Runs every statement on a line. When the worker reports, the line is
+ * echoed and each value is printed, otherwise only errors are written.
+ * Running out of memory ends the program, unless memory_escape is set.
+ * @param worker the worker
+ * @param line the line, which ends at its '\n' or a '\0'
+ * @param length the number of bytes in the line, with its '\n'
+ */
+void run_line(worker_t * worker, const char * line, size_t length) {
+    context_t *ctx = &worker->ctx;
+    stats_t *stats = ctx->stats;
+    uint64_t start = 0;
+    long long written = 0;
+
+    if (stats != NULL) {
+        stats->lines++;
+        stats->paren_depth = 0;
+        stats->stack_base = (uintptr_t) __builtin_frame_address(0);
+        written = ctx->out->write_ns;
+        start = stats_clock();
+    }
+
+    ctx->line = line;
+    ctx->line_index = 0;
+    ctx->stateful = 0;
+    arena_reset(&worker->arena);
+
+    if (worker->results != NULL) {
+        results_line(worker->results);
+    } else if (worker->report && worker->echo) {
+        output_echo(ctx->out, line, length);
+    }
+
+    if (worker->cache.max_bytes > 0) {
+        run_cached(worker, line, length);
+    } else {
+        run_statements(worker);
+    }
+
+    if (stats != NULL) {
+        stats->run += stats_clock() - start;
+        stats->run_write_ns += ctx->out->write_ns - written;
+    }
+}
+
+/**
+ * Creates an interpreter. Contexts share nothing, so each thread can
+ * evaluate with its own at the same time as the others. The variables of
+ * a context keep their values from one call to the next. Statements are
+ * parsed with iterative.c, so however deeply a string nests its
+ * parentheses it cannot run the calling thread out of stack; past
+ * MAX_DEPTH levels the statement is a syntax error.
+ * @param engine how statements are evaluated
+ * @return the new context, or NULL if there is no memory for it
+ */
+interp_ctx_t * interp_create(enum engine engine) {
+    interp_ctx_t *ctx = malloc(sizeof(interp_ctx_t));
+    jmp_buf escape;
+
+    if (ctx == NULL) {
+        return NULL;
+    }
+    if (setjmp(escape) != 0) {
+        memory_escape = NULL;
+        free(ctx);
+        return NULL;
+    }
+    memory_escape = &escape;
+    output_memory(&ctx->diagnostics);
+    memory_escape = NULL;
+    worker_init(&ctx->worker, engine, &ctx->diagnostics);
+    ctx->worker.report = 0;
+    ctx->worker.iterative = 1;
+    ctx->last = NULL;
+    ctx->last_capacity = 0;
+    return ctx;
+}
+
+/**
+ * Frees an interpreter and the diagnostics of its last call
+ * @param ctx the context, may be NULL
+ */
+void interp_destroy(interp_ctx_t * ctx) {
+    if (ctx == NULL) {
+        return;
+    }
+    worker_free(&ctx->worker);
+    free(ctx->diagnostics.data);
+    free(ctx->last);
+    free(ctx);
+}
+
+/**
+ * Copies a last line that has no '\n' so it can be followed by a '\0'
+ * @param ctx the context that keeps the copy
+ * @param line the line
+ * @param length the number of bytes in the line
+ * @return the copy
+ */
+static const char * terminate(interp_ctx_t * ctx, const char * line, size_t length) {
+    if (length + 1 > ctx->last_capacity) {
+        free(ctx->last);
+        ctx->last_capacity = 0;
+        ctx->last = malloc(length + 1);
+        if (ctx->last == NULL) {
+            out_of_memory("ERROR: out of memory for the last line");
+        }
+        ctx->last_capacity = length + 1;
+    }
+    memcpy(ctx->last, line, length);
+    ctx->last[length] = '\0';
+    return ctx->last;
+}
+
+/**
+ * Runs every line of a buffer and fills in the result. Running out of
+ * memory jumps back here and ends the call with INTERP_NO_MEMORY; what
+ * was allocated stays with the context, which can still be used.
+ * @param ctx the context
+ * @param data the statements
+ * @param size the number of bytes of statements
+ * @param terminated 1 if data[size] is a '\0' that may be read
+ * @param result where the values and diagnostics are stored
+ * @return 1 if every statement had a value, 0 otherwise
+ */
+static int eval(interp_ctx_t * ctx, const char * data, size_t size, int terminated,
+                interp_result_t * result) {
+    worker_t *worker = &ctx->worker;
+    size_t pos = 0;
+    jmp_buf escape;
+    int status;
+
+    worker->statements = 0;
+    worker->errors = 0;
+    worker->arithmetic_errors = 0;
+    worker->value = 0;
+    ctx->diagnostics.size = 0;
+
+    memory_escape = &escape;
+    if (setjmp(escape) == 0) {
+        while (pos < size) {
+            const char *line = data + pos;
+            const char *newline = memchr(line, '\n', size - pos);
+            size_t length;
+
+            if (newline != NULL) {
+                length = newline - line + 1;
+            } else {
+                length = size - pos;
+                if (!terminated) {
+                    line = terminate(ctx, line, length);
+                }
+            }
+            run_line(worker, line, length);
+            pos += length;
+        }
+
+        //keep the messages '\0' terminated without counting the '\0'
+        output_write(&ctx->diagnostics, "", 1);
+        ctx->diagnostics.size--;
+        status = INTERP_OK;
+    } else {
+        worker->ctx.out = &ctx->diagnostics;
+        //the messages of the line that ran out may be cut short to fit the '\0'
+        if (ctx->diagnostics.size == ctx->diagnostics.capacity) {
+            ctx->diagnostics.size--;
+        }
+        ctx->diagnostics.data[ctx->diagnostics.size] = '\0';
+        status = INTERP_NO_MEMORY;
+    }
+    memory_escape = NULL;
+
+    result->value = worker->value;
+    result->statements = worker->statements;
+    result->errors = worker->errors;
+    result->arithmetic_errors = worker->arithmetic_errors;
+    result->status = status;
+    result->diagnostics = ctx->diagnostics.data;
+    result->diagnostics_length = ctx->diagnostics.size;
+    return status == INTERP_OK && worker->errors == 0 && worker->arithmetic_errors == 0;
+}
+
+/**
+ * Evaluates every statement in a string, which may hold many lines.
+ * The diagnostics of the result stay valid until the next call with
+ * the same context.
+ * @param ctx the context
+ * @param text the statements, '\0' terminated
+ * @param result where the values and diagnostics are stored
+ * @return 1 if every statement had a value, 0 otherwise
+ */
+int interp_eval_string(interp_ctx_t * ctx, const char * text, interp_result_t * result) {
+    return eval(ctx, text, strlen(text), 1, result);
+}
+
+/**
+ * Evaluates every statement in a buffer that does not need to be '\0'
+ * terminated, such as a mapped file or a network read. The diagnostics
+ * of the result stay valid until the next call with the same context.
+ * @param ctx the context
+ * @param data the statements
+ * @param size the number of bytes of statements
+ * @param result where the values and diagnostics are stored
+ * @return 1 if every statement had a value, 0 otherwise
+ */
+int interp_eval_buffer(interp_ctx_t * ctx, const char * data, size_t size, interp_result_t * result) {
+    return eval(ctx, data, size, 0, result);
+}
+
+/**
+ * Turns on a cache of the lines a context has run, so a line it has seen
+ * before gets its values and diagnostics back without being parsed again
+ * @param ctx the context
+ * @param max_bytes most memory the cached lines may take
+ */
+void interp_cache(interp_ctx_t * ctx, size_t max_bytes) {
+    worker_cache(&ctx->worker, max_bytes);
+}
+
+/**
+ * Sets how deeply the statements of a context may nest their parentheses
+ * @param ctx the context
+ * @param depth the most levels, at least 1; deeper statements are
+ *              reported in the diagnostics as a syntax error
+ */
+void interp_max_depth(interp_ctx_t * ctx, int depth) {
+    ctx->worker.stack.max_depth = depth < 1 ? 1 : depth;
+}
+
+/**
+ * Reports how often lines were found in the cache of a context
+ * @param ctx the context
+ * @param hits set to the lines found
+ * @param misses set to the lines run and stored
+ */
+void interp_cache_counters(const interp_ctx_t * ctx, long * hits, long * misses) {
+    *hits = ctx->worker.cache.hits;
+    *misses = ctx->worker.cache.misses;
+}
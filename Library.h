@@ -0,0 +1,62 @@
+#ifndef LIBRARY_H
+   #define LIBRARY_H
+
+#include <stddef.h>
+
+/*
+ * The interpreter as a library. Nothing is global: every interp_ctx_t
+ * holds its own tokenizer, parser and engine state, so a program can
+ * evaluate in as many threads as it likes as long as each thread uses
+ * its own context. Variables belong to the context they were assigned
+ * in and keep their values from one call to the next. This header does
+ * not need any of the others.
+ */
+
+/* ways a statement can be parsed and evaluated */
+enum engine {
+    DIRECT_ENGINE, /* parser.c evaluates while it parses */
+    AST_ENGINE,    /* ast.c builds a tree, then evaluates it */
+    VM_ENGINE      /* the tree is compiled to bytecode for vm.c */
+};
+
+/* how a call to interp_eval_string or interp_eval_buffer ended */
+enum interp_status {
+    INTERP_OK,        /* every line was run */
+    INTERP_NO_MEMORY  /* memory ran out part way through a line; the rest of it and the lines after it were not run */
+};
+
+typedef struct interp_ctx interp_ctx_t;
+
+/*
+ * What one call to interp_eval_string or interp_eval_buffer found. A
+ * statement that divides by zero, or overflows in checked arithmetic,
+ * has no value: it is counted in arithmetic_errors, and its message is
+ * in the diagnostics. Nothing the statements do ends or traps the
+ * calling program: statements are parsed without recursion, and one that
+ * nests its parentheses deeper than the limit of interp_max_depth is a
+ * syntax error counted in errors.
+ */
+typedef struct interp_result {
+    int value;               // value of the last statement that had one
+    int statements;          // statements that had a value
+    int errors;              // lines that stopped at a lexical or syntax error
+    int arithmetic_errors;   // statements that divided by zero or overflowed
+    int status;              // enum interp_status
+    const char *diagnostics; // the error messages, '\0' terminated
+    size_t diagnostics_length;
+} interp_result_t;
+
+/*
+ * Purpose: Function Prototypes for library.c
+ * Date:    October 17, 2026
+ */
+interp_ctx_t *interp_create(enum engine engine);
+void interp_destroy(interp_ctx_t *ctx);
+int interp_eval_string(interp_ctx_t *ctx, const char *text, interp_result_t *result);
+int interp_eval_buffer(interp_ctx_t *ctx, const char *data, size_t size, interp_result_t *result);
+void interp_cache(interp_ctx_t *ctx, size_t max_bytes);
+void interp_max_depth(interp_ctx_t *ctx, int depth);
+void interp_cache_counters(const interp_ctx_t *ctx, long *hits, long *misses);
+
+
+#endif
@@ -0,0 +1,279 @@
+/*
+ * optimize.c - simplifies a tree from ast.c before it is evaluated.
+ * Operators whose operands are both numbers are folded into one number,
+ * variables are left alone since their values are only known when run,
+ * adding 0, multiplying or dividing by 1 and raising to 1 are dropped,
+ * ^ 2 becomes a SQUARE_NODE and * or / by a power of two becomes a shift.
+ * Every rewrite gives the same int as ast_eval would on the original tree,
+ * overflow included, and divisions without a result, like / 0, are left
+ * for the evaluator so it reports them.
+ * Parentheses never make nodes of their own, so there is no nesting of
+ * them to remove.
+ * Date:   October 17, 2026
+ */
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <limits.h>
+
+#include "Tokenizer.h"
+
+#include "Output.h"
+
+#include "Context.h"
+
+#include "Parser.h"
+
+#include "Ast.h"
+
+#include "Optimize.h"
+
+#include "Symbols.h"
+
+
+/* How each operator is written by ast_dump */
+static const char *node_names[] = {
+   [ADD_NODE] = " + ",
+   [SUB_NODE] = " - ",
+   [MULT_NODE] = " * ",
+   [DIV_NODE] = " / ",
+   [EXPON_NODE] = " ^ ",
+   [LESS_THEN_NODE] = " < ",
+   [LESS_THEN_OR_EQUAL_NODE] = " <= ",
+   [GREATER_THEN_NODE] = " > ",
+   [GREATER_THEN_OR_EQUAL_NODE] = " >= ",
+   [EQUALS_NODE] = " == ",
+   [NOT_EQUALS_NODE] = " != ",
+   [SHIFT_LEFT_NODE] = " << ",
+   [SHIFT_RIGHT_NODE] = " >> "
+};
+
+
+/**
+ * @param node a node
+ * @param value a number
+ * @return 1 if the node is a NUM_NODE holding value
+ */
+static int is_num(node_t * node, int value) {
+   return node->kind == NUM_NODE && node->value == value;
+}
+
+/**
+ * @param node a node
+ * @return k if the node is a NUM_NODE holding 2^k with k from 1 to 30, 0 otherwise
+ */
+static int power_of_two(node_t * node) {
+   int k;
+
+   if (node->kind != NUM_NODE || node->value < 2 || (node->value & (node->value - 1)))
+      return 0;
+   for (k = 0; (1 << k) != node->value; k++)
+      ;
+   return k;
+}
+
+/**
+ * Turns a node into a number that came from no digits of the line
+ * @param node the node
+ * @param value the number
+ */
+static void make_num(node_t * node, int value) {
+   node->kind = NUM_NODE;
+   node->left = NO_NODE;
+   node->right = NO_NODE;
+   node->value = value;
+}
+
+/**
+ * Rewrites an operator whose operands have been simplified already.
+ * @param ast the arena holding the tree
+ * @param index the operator
+ * @return what takes its place, index or one of its operands
+ */
+static int simplify(ast_t * ast, int index) {
+   node_t *node = &ast->nodes[index];
+   node_t *left;
+   node_t *right;
+   int shift;
+
+   if (node->kind == SQUARE_NODE || node->kind == SHIFT_LEFT_NODE || node->kind == SHIFT_RIGHT_NODE)
+      return index;
+   left = &ast->nodes[node->left];
+   right = &ast->nodes[node->right];
+
+   if (left->kind == NUM_NODE && right->kind == NUM_NODE) {
+      //dividing by 0 or INT_MIN by -1 is an error, leave it to be reported when evaluated
+      if (node->kind == DIV_NODE
+          && (right->value == 0 || (right->value == -1 && left->value == INT_MIN)))
+         return index;
+      make_num(node, ast_apply(ast, node, left->value, right->value));
+      return index;
+   }
+
+   switch (node->kind) {
+   case ADD_NODE:
+      if (is_num(right, 0))
+         return node->left;
+      if (is_num(left, 0))
+         return node->right;
+      break;
+   case SUB_NODE:
+      if (is_num(right, 0))
+         return node->left;
+      break;
+   case MULT_NODE:
+      if (is_num(right, 1))
+         return node->left;
+      if (is_num(left, 1))
+         return node->right;
+      //2^k * x is x << k, with the number moved to the right
+      if (power_of_two(left)) {
+         shift = node->left;
+         node->left = node->right;
+         node->right = shift;
+         left = &ast->nodes[node->left];
+         right = &ast->nodes[node->right];
+      }
+      if ((shift = power_of_two(right))) {
+         node->kind = SHIFT_LEFT_NODE;
+         make_num(right, shift);
+      }
+      break;
+   case DIV_NODE:
+      if (is_num(right, 1))
+         return node->left;
+      if ((shift = power_of_two(right))) {
+         node->kind = SHIFT_RIGHT_NODE;
+         make_num(right, shift);
+      }
+      break;
+   case EXPON_NODE:
+      if (is_num(right, 1))
+         return node->left;
+      if (is_num(right, 2)) {
+         node->kind = SQUARE_NODE;
+         node->right = NO_NODE;
+      }
+      break;
+   default:
+      break;
+   }
+   return index;
+}
+
+/**
+ * Rewrites the tree below a node in place, operands before the operators
+ * that use them. No nodes are added, so the arena never moves while the
+ * tree is being rewritten.
+ * @param ast the arena holding the tree
+ * @param root the root of the tree
+ * @return the root of the simplified tree, root or one of the nodes below it
+ */
+int optimize(ast_t * ast, int root) {
+   int count = ast_order(ast, root);
+   long long *top = ast->operands; // above what takes the place of each operand not yet used
+   int i;
+
+   for (i = 0; i < count; i++) {
+      int index = ast->order[i];
+      node_t *node = &ast->nodes[index];
+
+      if (node->kind != NUM_NODE && node->kind != VARIABLE_NODE) {
+         if (node->right != NO_NODE)
+            node->right = (int) *--top;
+         node->left = (int) *--top;
+         index = simplify(ast, index);
+      }
+      *top++ = index;
+   }
+   return (int) ast->operands[0];
+}
+
+/* something ast_dump still has to write: a node, or text when text is set */
+typedef struct dump_item {
+   const char *text;
+   int index;
+   int nested; // 1 if the node is the operand of another
+} dump_item_t;
+
+/* the items ast_dump has left to write, the next one on top */
+typedef struct dump_stack {
+   dump_item_t *items;
+   int count;
+   int capacity;
+} dump_stack_t;
+
+/**
+ * Puts an item on top of the stack
+ * @param stack the stack
+ * @param text the text to write, or NULL to write a node
+ * @param index the node
+ * @param nested 1 if the node is the operand of another
+ */
+static void push_item(dump_stack_t * stack, const char * text, int index, int nested) {
+   if (stack->count == stack->capacity) {
+      int capacity = stack->capacity ? stack->capacity * 2 : 64;
+      dump_item_t *items = realloc(stack->items, capacity * sizeof(dump_item_t));
+
+      if (items == NULL) {
+         free(stack->items);
+         out_of_memory("ERROR: out of memory for the syntax tree");
+      }
+      stack->items = items;
+      stack->capacity = capacity;
+   }
+   stack->items[stack->count].text = text;
+   stack->items[stack->count].index = index;
+   stack->items[stack->count].nested = nested;
+   stack->count++;
+}
+
+/**
+ * Writes the tree of a statement as "Tree is ..." on a line of its own,
+ * with parentheses around every operator but the outermost. Numbers are
+ * written the way they were in the line when they came from it, so wide
+ * literals are not cut to an int. What an operator writes is pushed last
+ * part first, so it comes off the stack in the order it is written.
+ * @param out where the tree is written
+ * @param ast the arena holding the tree
+ * @param root the root of the tree
+ */
+void ast_dump(output_t * out, ast_t * ast, int root) {
+   dump_stack_t stack = {NULL, 0, 0};
+
+   output_string(out, "Tree is ");
+   push_item(&stack, NULL, root, 0);
+   while (stack.count > 0) {
+      dump_item_t item = stack.items[--stack.count];
+      node_t *node = &ast->nodes[item.index];
+
+      if (item.text != NULL) {
+         output_string(out, item.text);
+      } else if (node->kind == NUM_NODE) {
+         if (node->left != NO_NODE)
+            output_write(out, ast->line + node->left, node->right);
+         else
+            output_int(out, node->value);
+      } else if (node->kind == VARIABLE_NODE) {
+         int length;
+         const char *name = symbols_name(ast->symbols, node->value, &length);
+
+         output_write(out, name, length);
+      } else if (node->kind == SQUARE_NODE) {
+         output_string(out, "square(");
+         push_item(&stack, ")", 0, 0);
+         push_item(&stack, NULL, node->left, 0);
+      } else {
+         if (item.nested) {
+            output_string(out, "(");
+            push_item(&stack, ")", 0, 0);
+         }
+         push_item(&stack, NULL, node->right, 1);
+         push_item(&stack, node_names[node->kind], 0, 0);
+         push_item(&stack, NULL, node->left, 1);
+      }
+   }
+   output_string(out, "\n");
+   free(stack.items);
+}
@@ -0,0 +1,12 @@
+#ifndef OPTIMIZE_H
+   #define OPTIMIZE_H
+
+/*
+ * Purpose: Function Prototypes for optimize.c
+ * Date:    October 17, 2026
+ */
+int optimize(ast_t *, int);
+void ast_dump(output_t *, ast_t *, int);
+
+
+#endif
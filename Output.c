@@ -0,0 +1,286 @@
+/**
+ * output.c - buffered writer used for everything the interpreter writes.
+ *
+ * Text and numbers are appended to one large buffer, integers are
+ * formatted by hand, and the file only sees a write when the buffer is
+ * full or at an explicit flush.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#include "./Output.h"
+
+__thread jmp_buf *memory_escape = NULL;
+
+/**
+ * Gives up on what needed more memory: jumps to memory_escape if it is
+ * set, otherwise prints the message and ends the program. Whatever ran
+ * out must still be in a state that can be freed.
+ *
+ * @param message what the memory was for
+ */
+void out_of_memory(const char *message) {
+    if (memory_escape != NULL) {
+        longjmp(*memory_escape, 1);
+    }
+    fprintf(stderr, "%s\n", message);
+    exit(1);
+}
+
+/**
+ * Points an output at a file descriptor that is already open.
+ *
+ * @param output the output to set up
+ * @param fd the file descriptor to write to
+ */
+void output_fd(output_t *output, int fd) {
+    output->fd = fd;
+    output->borrow = 0;
+    output->size = 0;
+    output->capacity = OUTPUT_SIZE;
+    output->queued = 0;
+    output->span_count = 0;
+    output->write_ns = 0;
+    output->data = malloc(output->capacity);
+    if (output->data == NULL) {
+        output->capacity = 0;
+        out_of_memory("ERROR: out of memory for the output buffer");
+    }
+}
+
+/**
+ * Sets up an output that only collects what is written in memory.
+ *
+ * @param output the output to set up
+ */
+void output_memory(output_t *output) {
+    output_fd(output, -1);
+}
+
+/**
+ * Creates or truncates a file for writing.
+ *
+ * @param output the output to set up
+ * @param path the file to write to
+ * @return 1 if successful, 0 if the file could not be opened
+ */
+int output_open(output_t *output, const char *path) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+
+    if (fd < 0) {
+        return 0;
+    }
+    output_fd(output, fd);
+    return 1;
+}
+
+/**
+ * Writes all of the spans, carrying on after partial writes.
+ *
+ * @param output the output
+ * @param spans the spans to write
+ * @param count the number of spans
+ */
+static void write_spans(output_t *output, struct iovec *spans, int count) {
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (count > 0) {
+        ssize_t written = writev(output->fd, spans, count);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "ERROR: could not write output\n");
+            exit(1);
+        }
+        //skip the spans that were written completely
+        while (count > 0 && (size_t) written >= spans->iov_len) {
+            written -= spans->iov_len;
+            spans++;
+            count--;
+        }
+        if (count > 0) {
+            spans->iov_base = (char *) spans->iov_base + written;
+            spans->iov_len -= written;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    output->write_ns += (end.tv_sec - start.tv_sec) * 1000000000LL + (end.tv_nsec - start.tv_nsec);
+}
+
+/**
+ * Queues the part of the buffer that is not queued yet as a span.
+ *
+ * @param output the output
+ */
+static void queue_buffer(output_t *output) {
+    if (output->size > output->queued) {
+        output->spans[output->span_count].iov_base = output->data + output->queued;
+        output->spans[output->span_count].iov_len = output->size - output->queued;
+        output->span_count++;
+        output->queued = output->size;
+    }
+}
+
+/**
+ * Writes everything buffered or queued so far to the file.
+ *
+ * @param output the output
+ */
+void output_flush(output_t *output) {
+    if (output->fd < 0) {
+        return;
+    }
+    queue_buffer(output);
+    write_spans(output, output->spans, output->span_count);
+    output->size = 0;
+    output->queued = 0;
+    output->span_count = 0;
+}
+
+/**
+ * Appends bytes to the buffer, flushing whenever it fills up.
+ *
+ * @param output the output
+ * @param bytes the bytes to write
+ * @param length the number of bytes
+ */
+void output_write(output_t *output, const char *bytes, size_t length) {
+    if (output->fd < 0) {
+        //in memory, so make room instead of flushing
+        if (length > output->capacity - output->size) {
+            size_t capacity = output->capacity ? output->capacity : OUTPUT_SIZE;
+            char *data;
+
+            while (length > capacity - output->size) {
+                capacity *= 2;
+            }
+            data = realloc(output->data, capacity);
+            if (data == NULL) {
+                out_of_memory("ERROR: out of memory for the output buffer");
+            }
+            output->data = data;
+            output->capacity = capacity;
+        }
+    } else if (length >= OUTPUT_SIZE) {
+        //too big to be worth copying, write it straight after the buffer
+        struct iovec span = {(char *) bytes, length};
+
+        output_flush(output);
+        write_spans(output, &span, 1);
+        return;
+    }
+    while (length > output->capacity - output->size) {
+        size_t part = output->capacity - output->size;
+
+        memcpy(output->data + output->size, bytes, part);
+        output->size += part;
+        bytes += part;
+        length -= part;
+        output_flush(output);
+    }
+    memcpy(output->data + output->size, bytes, length);
+    output->size += length;
+}
+
+/**
+ * Appends a null terminated string.
+ *
+ * @param output the output
+ * @param string the string to write
+ */
+void output_string(output_t *output, const char *string) {
+    output_write(output, string, strlen(string));
+}
+
+/**
+ * Appends an int in decimal, without going through printf.
+ *
+ * @param output the output
+ * @param value the number to write
+ */
+void output_int(output_t *output, int value) {
+    output_long(output, value);
+}
+
+/**
+ * Appends a 64-bit integer in decimal.
+ *
+ * @param output the output
+ * @param value the number to write
+ */
+void output_long(output_t *output, long long value) {
+    char digits[21];
+    char *pos = digits + sizeof(digits);
+    unsigned long long magnitude = value < 0 ? 0ull - (unsigned long long) value
+                                             : (unsigned long long) value;
+
+    do {
+        *--pos = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        *--pos = '-';
+    }
+    output_write(output, pos, digits + sizeof(digits) - pos);
+}
+
+/**
+ * Appends a line of the input. When borrowing, a long line is queued
+ * where it is instead of being copied, so it must stay valid until the
+ * next flush.
+ *
+ * @param output the output
+ * @param bytes the first byte of the line
+ * @param length the number of bytes
+ */
+void output_echo(output_t *output, const char *bytes, size_t length) {
+    if (!output->borrow || length < BORROW_MIN) {
+        output_write(output, bytes, length);
+        return;
+    }
+
+    //room for this span and the rest of the buffer after it
+    if (output->span_count + 2 > OUTPUT_SPANS) {
+        output_flush(output);
+    }
+    queue_buffer(output);
+    output->spans[output->span_count].iov_base = (char *) bytes;
+    output->spans[output->span_count].iov_len = length;
+    output->span_count++;
+}
+
+/**
+ * Appends everything collected by an in-memory output and empties it.
+ *
+ * @param output the output to append to
+ * @param from the in-memory output
+ */
+void output_drain(output_t *output, output_t *from) {
+    output_write(output, from->data, from->size);
+    from->size = 0;
+}
+
+/**
+ * Flushes the output and closes the file.
+ *
+ * @param output the output
+ */
+void output_close(output_t *output) {
+    output_flush(output);
+    free(output->data);
+    if (output->fd >= 0) {
+        close(output->fd);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef OUTPUT_H
+   #define OUTPUT_H
+
+#include <stddef.h>
+#include <setjmp.h>
+#include <sys/uio.h>
+
+#define OUTPUT_SIZE 1048576 // bytes buffered before they are written
+#define OUTPUT_SPANS 1023   // spans queued before they are written, below IOV_MAX
+#define BORROW_MIN 4096     // shorter echoed lines are cheaper to copy
+
+/*
+ * An output file with one large reusable buffer. Nothing reaches the file
+ * until the buffer fills up or output_flush is called. When borrow is set,
+ * long echoed lines are not copied: they are queued as spans of the input
+ * and written together with the buffer by one writev.
+ * An output without a file (fd -1) keeps everything in memory, growing
+ * its buffer, until it is drained into another output.
+ */
+typedef struct output {
+    int fd;
+    int borrow;               // 1 if echoed spans stay valid until the next flush
+    char *data;               // the buffer
+    size_t size;              // bytes used in the buffer
+    size_t capacity;          // size of the buffer
+    size_t queued;            // bytes of the buffer already queued in spans
+    struct iovec spans[OUTPUT_SPANS + 1];
+    int span_count;
+    long long write_ns;       // time spent writing to the file
+} output_t;
+
+/*
+ * Where out_of_memory jumps to on this thread instead of exiting, or NULL.
+ * The library sets it for the length of a call, so that running out of
+ * memory comes back to the program that embeds it as an error.
+ */
+extern __thread jmp_buf *memory_escape;
+
+/*
+ * Purpose: Function Prototypes for output.c
+ * Date:    October 17, 2026
+ */
+int output_open(output_t *output, const char *path);
+void output_fd(output_t *output, int fd);
+void output_memory(output_t *output);
+void output_drain(output_t *output, output_t *from);
+void output_write(output_t *output, const char *bytes, size_t length);
+void output_string(output_t *output, const char *string);
+void output_int(output_t *output, int value);
+void output_long(output_t *output, long long value);
+void output_echo(output_t *output, const char *bytes, size_t length);
+void output_flush(output_t *output);
+void output_close(output_t *output);
+void out_of_memory(const char *message);
+
+
+#endif
@@ -0,0 +1,353 @@
+/**
+ * parallel.c - runs the lines of the input on a pool of threads.
+ *
+ * Lines without variables are independent, so the input is cut into
+ * chunks of consecutive lines. Each worker thread takes the next filled
+ * chunk, runs it with its own context and writes the results to the
+ * chunk's in-memory output. The main thread keeps filling chunks and
+ * appends their outputs in input order, so the output is the same as a
+ * run without threads.
+ *
+ * A line with a name in it may read what an earlier line assigned, so a
+ * chunk with such a line is stateful: every stateful chunk is run by the
+ * lane, one worker whose variables they share, in input order. A worker
+ * thread that takes one waits for the stateful chunk before it to be run.
+ * Lines without names still go to any worker, so only the lines that can
+ * depend on each other are run one after another. To keep chunks from
+ * getting short where the two kinds of lines alternate, a stateful chunk
+ * takes the lines without names that follow a name, up to SPLIT_LINES of
+ * them in a row.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "Library.h"
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Ast.h"
+#include "Big.h"
+#include "Arith.h"
+#include "Vm.h"
+#include "Iterative.h"
+#include "Cache.h"
+#include "Arena.h"
+#include "Stats.h"
+#include "Input.h"
+#include "Symbols.h"
+#include "Interpreter.h"
+
+#define CHUNK_LINES 4096      // most lines in a chunk
+#define CHUNK_BYTES 1048576   // a chunk is full once its lines pass this size
+#define CHUNKS_PER_THREAD 4   // chunks in flight for each worker
+#define SPLIT_LINES 64        // lines without names in a row that end a stateful chunk,
+                              // and that a chunk needs before a name ends it
+
+/* one line of a chunk */
+typedef struct span {
+    const char *start;
+    size_t offset; // where the line was copied to, if the input is not mapped
+    size_t length;
+} span_t;
+
+/* a run of consecutive lines and the output they produce */
+typedef struct chunk {
+    span_t *lines;
+    int count;
+    char *text;            // copies of the lines when the input is not mapped
+    size_t text_size;
+    size_t text_capacity;
+    output_t out;
+    int stateful;          // 1 if a line has a name, so the lane runs the chunk
+    long turn;             // the stateful chunks filled before this one
+    int done;              // 1 once a worker has run every line
+} chunk_t;
+
+/* state shared between the main thread and the workers */
+typedef struct pool {
+    pthread_mutex_t lock;
+    pthread_cond_t ready;  // a chunk was filled, or the input has ended
+    pthread_cond_t done;   // a chunk has been run
+    chunk_t *chunks;
+    int slots;
+    long filled;           // chunks filled by the main thread so far
+    long taken;            // chunks taken by workers so far
+    int finished;          // 1 once no more chunks will be filled
+    worker_t *settings;    // the engine and options every worker copies
+    size_t cache_bytes;    // the share of the cache each worker gets
+    worker_t lane;         // runs the stateful chunks, which share its variables
+    long lane_turn;        // stateful chunks the lane has run so far
+} pool_t;
+
+
+/**
+ * Copies a line into the text of a chunk, keeping a '\0' after it.
+ *
+ * @param chunk the chunk
+ * @param span the line, its offset is set to where it was copied
+ */
+static void copy_line(chunk_t *chunk, span_t *span) {
+    if (chunk->text_size + span->length + 1 > chunk->text_capacity) {
+        chunk->text_capacity = 2 * (chunk->text_size + span->length + 1);
+        chunk->text = realloc(chunk->text, chunk->text_capacity);
+        if (chunk->text == NULL) {
+            fprintf(stderr, "ERROR: out of memory for a chunk of input\n");
+            exit(1);
+        }
+    }
+    span->offset = chunk->text_size;
+    memcpy(chunk->text + chunk->text_size, span->start, span->length);
+    chunk->text_size += span->length;
+    chunk->text[chunk->text_size++] = '\0';
+}
+
+/**
+ * Fills a chunk with the next lines of the input. Lines of a mapped input
+ * stay where they are, other lines are copied since the input reuses its
+ * buffer.
+ *
+ * @param chunk the chunk, which is stateful if one of its lines has a name
+ * @param input the input
+ * @param held a line with a name that ended the last chunk, which starts
+ *             this one; set to the line with a name that ends this one,
+ *             which stays valid until the input is read again. Its start
+ *             is NULL when there is none.
+ * @return the number of lines in the chunk, 0 at the end of the input
+ */
+static int fill_chunk(chunk_t *chunk, input_t *input, span_t *held) {
+    size_t bytes = 0;
+    int nameless = 0; // lines without a name at the end of the chunk
+    int i;
+
+    chunk->count = 0;
+    chunk->text_size = 0;
+    chunk->stateful = 0;
+    while (chunk->count < CHUNK_LINES && bytes < CHUNK_BYTES && nameless < SPLIT_LINES) {
+        span_t *span = &chunk->lines[chunk->count];
+
+        if (held->start != NULL) {
+            *span = *held;
+            held->start = NULL;
+        } else if (!input_next_line(input, &span->start, &span->length)) {
+            break;
+        }
+        if (!has_identifier(span->start)) {
+            nameless += chunk->stateful;
+        } else if (!chunk->stateful && chunk->count >= SPLIT_LINES) {
+            //the lines so far can run on any worker
+            *held = *span;
+            break;
+        } else {
+            chunk->stateful = 1;
+            nameless = 0;
+        }
+        if (!input->mapped) {
+            copy_line(chunk, span);
+        }
+        bytes += span->length;
+        chunk->count++;
+    }
+
+    //the copies are only in place once the text has stopped growing
+    if (!input->mapped) {
+        for (i = 0; i < chunk->count; i++) {
+            chunk->lines[i].start = chunk->text + chunk->lines[i].offset;
+        }
+    }
+    return chunk->count;
+}
+
+/**
+ * Adds what a worker counted to the worker the pool was started with.
+ *
+ * @param settings the worker the pool was started with
+ * @param worker a worker of the pool
+ */
+static void add_counters(worker_t *settings, worker_t *worker) {
+    settings->cache.hits += worker->cache.hits;
+    settings->cache.misses += worker->cache.misses;
+    settings->statements += worker->statements;
+    settings->errors += worker->errors;
+    settings->arithmetic_errors += worker->arithmetic_errors;
+    if (worker->ctx.stats != NULL) {
+        stats_add(&settings->stats, &worker->stats);
+    }
+}
+
+/**
+ * The body of a worker thread: runs chunks until there are no more.
+ *
+ * @param arg the pool
+ * @return NULL
+ */
+static void *work(void *arg) {
+    pool_t *pool = arg;
+    worker_t worker;
+    worker_t *runner; // the worker that runs the chunk, the lane if it is stateful
+    chunk_t *chunk;
+    int i;
+
+    worker_init(&worker, pool->settings->engine, NULL);
+    worker_settings(&worker, pool->settings);
+    if (pool->cache_bytes > 0) {
+        worker_cache(&worker, pool->cache_bytes);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->taken == pool->filled && !pool->finished) {
+            pthread_cond_wait(&pool->ready, &pool->lock);
+        }
+        if (pool->taken == pool->filled) {
+            break;
+        }
+        chunk = &pool->chunks[pool->taken++ % pool->slots];
+        runner = &worker;
+        if (chunk->stateful) {
+            //the stateful chunk before it was taken first, so it is running
+            while (pool->lane_turn != chunk->turn) {
+                pthread_cond_wait(&pool->done, &pool->lock);
+            }
+            runner = &pool->lane;
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        runner->ctx.out = &chunk->out;
+        for (i = 0; i < chunk->count; i++) {
+            run_line(runner, chunk->lines[i].start, chunk->lines[i].length);
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        chunk->done = 1;
+        pool->lane_turn += chunk->stateful;
+        pthread_cond_broadcast(&pool->done);
+    }
+    add_counters(pool->settings, &worker);
+    pthread_mutex_unlock(&pool->lock);
+
+    worker_free(&worker);
+    return NULL;
+}
+
+/**
+ * Runs every line of the input on a number of threads, writing the
+ * results in the same order as a run without threads would.
+ *
+ * @param input the input
+ * @param out where the results are written
+ * @param settings a worker whose engine and options the threads use, each
+ *                 thread and the lane get an equal share of its cache and
+ *                 add their counters and stats to it
+ * @param threads the number of worker threads
+ */
+void run_parallel(input_t * input, output_t * out, worker_t * settings, int threads) {
+    pool_t pool;
+    pthread_t *ids = malloc(threads * sizeof(pthread_t));
+    long written = 0; // chunks appended to out so far
+    long stateful = 0; // stateful chunks filled so far
+    int more = 1;     // 0 once the input has ended
+    span_t held;      // a line with a name that starts the next chunk
+    chunk_t *chunk;
+    int i;
+
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.ready, NULL);
+    pthread_cond_init(&pool.done, NULL);
+    pool.slots = threads * CHUNKS_PER_THREAD;
+    pool.chunks = calloc(pool.slots, sizeof(chunk_t));
+    pool.filled = 0;
+    pool.taken = 0;
+    pool.finished = 0;
+    pool.settings = settings;
+    pool.cache_bytes = settings->cache.max_bytes / (threads + 1);
+    pool.lane_turn = 0;
+    worker_init(&pool.lane, settings->engine, NULL);
+    worker_settings(&pool.lane, settings);
+    if (pool.cache_bytes > 0) {
+        worker_cache(&pool.lane, pool.cache_bytes);
+    }
+    held.start = NULL;
+    if (ids == NULL || pool.chunks == NULL) {
+        fprintf(stderr, "ERROR: out of memory for the thread pool\n");
+        exit(1);
+    }
+    for (i = 0; i < pool.slots; i++) {
+        pool.chunks[i].lines = malloc(CHUNK_LINES * sizeof(span_t));
+        if (pool.chunks[i].lines == NULL) {
+            fprintf(stderr, "ERROR: out of memory for the thread pool\n");
+            exit(1);
+        }
+        output_memory(&pool.chunks[i].out);
+    }
+
+    for (i = 0; i < threads; i++) {
+        if (pthread_create(&ids[i], NULL, work, &pool) != 0) {
+            fprintf(stderr, "ERROR: could not start a worker thread\n");
+            exit(1);
+        }
+    }
+
+    for (;;) {
+        //hand out every free slot before waiting on the oldest chunk
+        while (more && pool.filled - written < pool.slots) {
+            uint64_t start = stats_clock();
+            int count;
+
+            chunk = &pool.chunks[pool.filled % pool.slots];
+            count = fill_chunk(chunk, input, &held);
+            if (settings->ctx.stats != NULL) {
+                settings->stats.read += stats_clock() - start;
+            }
+            if (count == 0) {
+                more = 0;
+                break;
+            }
+            chunk->turn = stateful;
+            stateful += chunk->stateful;
+            pthread_mutex_lock(&pool.lock);
+            chunk->done = 0;
+            pool.filled++;
+            pthread_cond_signal(&pool.ready);
+            pthread_mutex_unlock(&pool.lock);
+        }
+        if (written == pool.filled) {
+            break;
+        }
+
+        chunk = &pool.chunks[written % pool.slots];
+        pthread_mutex_lock(&pool.lock);
+        while (!chunk->done) {
+            pthread_cond_wait(&pool.done, &pool.lock);
+        }
+        pthread_mutex_unlock(&pool.lock);
+
+        output_drain(out, &chunk->out);
+        written++;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.finished = 1;
+    pthread_cond_broadcast(&pool.ready);
+    pthread_mutex_unlock(&pool.lock);
+    for (i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    add_counters(settings, &pool.lane);
+    worker_free(&pool.lane);
+
+    for (i = 0; i < pool.slots; i++) {
+        output_close(&pool.chunks[i].out);
+        free(pool.chunks[i].lines);
+        free(pool.chunks[i].text);
+    }
+    free(pool.chunks);
+    free(ids);
+    pthread_cond_destroy(&pool.done);
+    pthread_cond_destroy(&pool.ready);
+    pthread_mutex_destroy(&pool.lock);
+}
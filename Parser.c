@@ -14,17 +14,23 @@
 
 #include <math.h>
 
-#include "tokenizer.h"
+#include "Tokenizer.h"
 
-#include "parser.h"
+#include "Output.h"
 
+#include "Context.h"
 
-char lex_error[OPSIZE]; //global variable to store lexical errors.
-int syntax_error = 0; // value to represent a syntax error
+#include "Parser.h"
+
+#include "Big.h"
+
+#include "Stats.h"
+
+#include "Symbols.h"
 
 
 /*
- * <bexpr> ::= <expr> ;
+ * <bexpr> ::= <name> = <expr> ; | <expr> ;
  * <expr> ::=  <term> <ttail>
  * <ttail> ::=  <add_sub_tok> <term> <ttail> | e
  * <term> ::=  <stmt> <stail>
@@ -32,29 +38,42 @@ int syntax_error = 0; // value to represent a syntax error
  * <stmt> ::=  <factor> <ftail>
  * <ftail> ::=  <compare_tok> <factor> <ftail> | e
  * <factor> ::=  <expp> ^ <factor> | <expp>
- * <expp> ::=  ( <expr> ) | <num>
+ * <expp> ::=  ( <expr> ) | <num> | <name>
  * <add_sub_tok> ::=  + | -
  * <mul_div_tok> ::=  * | /
  * <compare_tok> ::=  < | > | <= | >= | != | ==
  * <num> ::=  {0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9}+
+ * <name> ::=  {a-z | A-Z | _} {a-z | A-Z | _ | 0-9}*
+ */
+
+/**
+ * Marks the current statement as having no value. The value returned
+ * alongside is never used, so every int stays a valid result.
+ * @param ctx the line being read and the error state
+ * @return 0
  */
+static int fail(context_t * ctx) {
+   ctx->failed = 1;
+   return 0;
+}
 
 /**
  * <expr> -> <term> <ttail>
  * The function for the non-terminal <expr> that views
  * the expression as a series of terms and addition and
  * subtraction operators.
+ * @param ctx the line being read and the error state
  * @param token: the current lexeme
- * @return: the number of the evaluated expression or an error
+ * @return: the number of the evaluated expression, ctx->failed is set on an error
  */
-int expr(char * token) {
+int expr(context_t * ctx, token_t * token) {
    int exprReturn;
-   int subtotal = term(token);
-   if (subtotal == ERROR) {
+   int subtotal = term(ctx, token);
+   if (ctx->failed) {
 
       return subtotal;
    } else {
-      exprReturn = ttail(token, subtotal);
+      exprReturn = ttail(ctx, token, subtotal);
       return exprReturn;
    }
 }
@@ -62,53 +81,60 @@ int expr(char * token) {
 /**
  * The function for the non terminal <term> that views
  * the term  as a series of statements and statement tails.
+ * @param ctx the line being read and the error state
  * @param token the current lexeme
  * @return the number of the evaluated term
  */
-int term(char * token) {
+int term(context_t * ctx, token_t * token) {
    int termReturn;
-   int statement = stmt(token);
-   if (statement == ERROR)
+   int statement = stmt(ctx, token);
+   if (ctx->failed)
       return statement;
    else
-      termReturn = stail(token, statement);
+      termReturn = stail(ctx, token, statement);
    return termReturn;
 }
 
 /**
  * The function for the non terminal <stmt> that views
  * the statement as a series factors and factor tails.
+ * @param ctx the line being read and the error state
  * @param token the current lexeme
  * @return the number of the evaluated statement
  */
-int stmt(char * token) {
+int stmt(context_t * ctx, token_t * token) {
    int stmtReturn;
-   int fac = factor(token);
-   if (fac == ERROR)
+   int fac = factor(ctx, token);
+   if (ctx->failed)
       return fac;
    else
-      stmtReturn = ftail(token, fac);
+      stmtReturn = ftail(ctx, token, fac);
    return stmtReturn;
 }
 
 /**
+ * <bexpr> ::= <name> = <expr> ; | <expr> ;
  * The function for the non terminal <bexpr> that starts the evaluation of the expression
+ * @param ctx the line being read and the error state
  * @param token the current lexeme
- * @return the evaluation of the expression
+ * @return the evaluation of the expression, ctx->failed is set if it has none
  */
-int bexpr(char * token) {
-   syntax_error = 0;
+int bexpr(context_t * ctx, token_t * token) {
+   ctx->syntax_error = 0;
+   ctx->failed = 0;
+   ctx->status = ARITH_OK;
    //Will hold the return value.
    int to_return;
 
+   //Skip past "name =", the caller stores the value in ctx->target
+   assignment(ctx, token);
 
    //Pass the token down to expr
-   to_return = expr(token);
+   to_return = expr(ctx, token);
 
    //Make sure there is a semicolon
-   if (strcmp(token, ";") != 0) {
-      strcpy(lex_error, ";");
-      syntax_error = 1;
+   if (!statement_end(ctx, token, !ctx->failed)) {
+      return fail(ctx);
    }
    return to_return;
 }
@@ -119,34 +145,35 @@ int bexpr(char * token) {
  * the rest of an arithmetic expression after the initial
  * term. So it expects an addition or subtraction operator
  * first or the empty string. 
+ * @param ctx the line being read and the error state
  * @param token: the line being read
  * @param subtotal: the number we have evaluated up to this
  *                  point
  * @return: the number of the evaluated expression or an error
  */
-int ttail(char * token, int subtotal) {
+int ttail(context_t * ctx, token_t * token, int subtotal) {
    int term_value;
 
    //checks if the current token is the add operator.
-   if (!strncmp(token, "+", 1)) {
-      add_sub_tok(token);
-      term_value = term(token);
+   if (token->kind == ADD_OP) {
+      add_sub_tok(ctx, token);
+      term_value = term(ctx, token);
 
       // if term returned an error, give up otherwise call ttail
-      if (term_value == ERROR)
+      if (ctx->failed)
          return term_value;
       else
-         term_value = ttail(token, (subtotal + term_value));
+         term_value = ttail(ctx, token, (subtotal + term_value));
       return term_value;
-   } else if (!strncmp(token, "-", 1)) {
-      add_sub_tok(token);
-      term_value = term(token);
+   } else if (token->kind == SUB_OP) {
+      add_sub_tok(ctx, token);
+      term_value = term(ctx, token);
 
       // if term returned an error, give up otherwise call ttail
-      if (term_value == ERROR)
+      if (ctx->failed)
          return term_value;
       else
-         return ttail(token, (subtotal - term_value));
+         return ttail(ctx, token, (subtotal - term_value));
    }
    /* empty string */
    else
@@ -157,63 +184,72 @@ int ttail(char * token, int subtotal) {
 
 /**
  * Move the pointer along to the next lexeme
+ * @param ctx the line being read and the error state
  * @param token the current lexeme
  */
-void add_sub_tok(char * token) {
-   get_token(token);
+void add_sub_tok(context_t * ctx, token_t * token) {
+   get_token(ctx, token);
 
 }
 
 /**
  * Move the pointer along to the next lexeme
+ * @param ctx the line being read and the error state
  * @param token the current lexeme
  */
-void mult_div_tok(char * token) {
-   get_token(token);
+void mult_div_tok(context_t * ctx, token_t * token) {
+   get_token(ctx, token);
 
 }
 
 /**
  * Move the pointer along to the next lexeme
+ * @param ctx the line being read and the error state
  * @param token the current lexeme
  */
-void compare_tok(char * token) {
-   get_token(token);
+void compare_tok(context_t * ctx, token_t * token) {
+   get_token(ctx, token);
 
 }
 
 /**
- * <expp> ::=  ( <expr> ) | <num>
- * The function for the non terminal <expp> responsible for parenthesis and numbers.
+ * <expp> ::=  ( <expr> ) | <num> | <name>
+ * The function for the non terminal <expp> responsible for parenthesis, numbers and names.
+ * @param ctx the line being read and the error state
  * @param token the current lexeme
  * @return the evaluated number
  */
-int expp(char * token) {
+int expp(context_t * ctx, token_t * token) {
 
    int to_return;
 
-   if (strcmp(curr_cat, "LEFT_PAREN") == 0){
-      if (!get_token(token)){
-         return ERROR;
+   if (token->kind == LEFT_PAREN){
+      if (!get_token(ctx, token)){
+         return fail(ctx);
       }
 
-      to_return = expr(token);
-      if (strcmp(curr_cat, "RIGHT_PAREN") != 0) {
+      to_return = expr(ctx, token);
+      if (token->kind != RIGHT_PAREN) {
          //No closing parenthesis error
-         strcpy(lex_error, ")");
-         syntax_error = 1;
-         fprintf(out_file, "===> ')' expected\nSyntax Error\n");
-         return ERROR;
+         strcpy(ctx->lex_error, ")");
+         ctx->syntax_error = 1;
+         output_string(ctx->out, "===> ')' expected\nSyntax Error\n");
+         ctx->reported = 1;
+         return fail(ctx);
       }else{
-         if (!get_token(token)){
-            return ERROR;
+         if (!get_token(ctx, token)){
+            return fail(ctx);
          }
       }
    }
+   //A name stands for the value of its variable
+   else if (token->kind == IDENTIFIER) {
+      to_return = name(ctx, token);
+   }
    //If there is no parenthesis, store the value of the
    //number in to_return.
    else {
-      to_return = num(token);
+      to_return = num(ctx, token);
    }
    return to_return;
 }
@@ -223,21 +259,25 @@ int expp(char * token) {
  * <factor> ::=  <expp> ^ <factor> | <expp>
  * The function for the non terminal <factor> responsible for exponential expressions
  */
-int factor(char * token) {
+int factor(context_t * ctx, token_t * token) {
    int factor_num;
-   factor_num = expp(token);
+   int exponent;
+   factor_num = expp(ctx, token);
 
-   if (strcmp(curr_cat, "EXPON_OP") == 0) {
-      if (!get_token(token)) {
-         return ERROR;
+   if (token->kind == EXPON_OP) {
+      if (!get_token(ctx, token)) {
+         return fail(ctx);
       }
 
 
 
-      if (factor_num == ERROR) {
+      if (ctx->failed) {
          return factor_num;
       } else {
-         factor_num = pow(factor_num, factor(token));
+         exponent = factor(ctx, token);
+         if (ctx->failed)
+            return exponent;
+         factor_num = pow(factor_num, exponent);
       }
    }
 
@@ -249,75 +289,76 @@ int factor(char * token) {
 /**
  * <ftail> ::=  <compare_tok> <factor> <ftail> | e
  * The function for the non terminal <ftail> responsible for comparison operators.
+ * @param ctx the line being read and the error state
  * @param token the current lexeme
  * @return the evaluated expression from the comparison
  *
  */
-int ftail(char * token, int subtotal) {
+int ftail(context_t * ctx, token_t * token, int subtotal) {
 
    int compare_value;
    //If the current token is the less than operator, get the next token,
    //pass it to factor and then recurse.
-   if (strcmp(curr_cat, "LESS_THEN_OP") == 0) {
-      compare_tok(token); // move token
-      compare_value = factor(token);
+   if (token->kind == LESS_THEN_OP) {
+      compare_tok(ctx, token); // move token
+      compare_value = factor(ctx, token);
 
-      if (compare_value == ERROR) {
+      if (ctx->failed) {
          return compare_value;
       } else {
-         return ftail(token, subtotal < compare_value);
+         return ftail(ctx, token, subtotal < compare_value);
       }
       //If the current token is the greater than operator, get the next token,
       //pass it to factor and then recurse.
-   } else if (strcmp(curr_cat, "GREATER_THEN_OP") == 0) {
-      compare_tok(token);
-      compare_value = factor(token);
-      if (compare_value == ERROR) {
+   } else if (token->kind == GREATER_THEN_OP) {
+      compare_tok(ctx, token);
+      compare_value = factor(ctx, token);
+      if (ctx->failed) {
          return compare_value;
       } else {
-         return ftail(token, subtotal > compare_value);
+         return ftail(ctx, token, subtotal > compare_value);
       }
        //If the current token is the less than or equal operator, get the next token,
        //pass it to factor and then recurse.
-   } else if (strcmp(curr_cat, "LESS_THEN_OR_EQUAL_OP") == 0) {
-      compare_tok(token);
-      compare_value = factor(token);
-      if (compare_value == ERROR) {
+   } else if (token->kind == LESS_THEN_OR_EQUAL_OP) {
+      compare_tok(ctx, token);
+      compare_value = factor(ctx, token);
+      if (ctx->failed) {
          return compare_value;
       } else {
-         return ftail(token, subtotal <= compare_value);
+         return ftail(ctx, token, subtotal <= compare_value);
       }
        //If the current token is the greater than or equal operator, get the next token,
        //pass it to factor and then recurse.
-   } else if (strcmp(curr_cat, "GREATER_THEN_OR_EQUAL_OP") == 0) {
-      compare_tok(token);
+   } else if (token->kind == GREATER_THEN_OR_EQUAL_OP) {
+      compare_tok(ctx, token);
 
-      compare_value = factor(token);
-      if (compare_value == ERROR) {
+      compare_value = factor(ctx, token);
+      if (ctx->failed) {
          return compare_value;
       } else {
-         return ftail(token, subtotal >= compare_value);
+         return ftail(ctx, token, subtotal >= compare_value);
       }
        //If the current token is the equals' operator, get the next token,
        //pass it to factor and then recurse.
-   } else if (strcmp(curr_cat, "EQUALS_OP") == 0) {
-      compare_tok(token);
-      compare_value = factor(token);
-      if (compare_value == ERROR) {
+   } else if (token->kind == EQUALS_OP) {
+      compare_tok(ctx, token);
+      compare_value = factor(ctx, token);
+      if (ctx->failed) {
          return compare_value;
       } else {
-         return ftail(token, subtotal == compare_value);
+         return ftail(ctx, token, subtotal == compare_value);
       }
        //If the current token is the not equals' operator, get the next token,
        //pass it to factor and then recurse.
-   } else if (strcmp(curr_cat, "NOT_EQUALS_OP") == 0) {
-      compare_tok(token);
+   } else if (token->kind == NOT_EQUALS_OP) {
+      compare_tok(ctx, token);
 
-      compare_value = factor(token);
-      if (compare_value == ERROR) {
+      compare_value = factor(ctx, token);
+      if (ctx->failed) {
          return compare_value;
       } else {
-         return ftail(token, subtotal != compare_value);
+         return ftail(ctx, token, subtotal != compare_value);
       }
    } else {
       return subtotal;
@@ -328,36 +369,37 @@ int ftail(char * token, int subtotal) {
 /**
  * <stail> ::=  <mult_div_tok> <stmt> <stail> | e
  * The function for the non terminal <stail> responsible for the multiplication and division operators
+ * @param ctx the line being read and the error state
  * @param token the current lexeme
  * @return the evaluated expression from the operators
  */
-int stail(char * token, int subtotal) {
+int stail(context_t * ctx, token_t * token, int subtotal) {
 
    //Hold the value of this statement.
    int stmt_value;
 
    //If the current token is the mult opp, get the next token,
    //pass it to stmt and then recurse.
-   if (strcmp(curr_cat, "MULT_OP") == 0) {
-      mult_div_tok(token);
-      stmt_value = stmt(token);
+   if (token->kind == MULT_OP) {
+      mult_div_tok(ctx, token);
+      stmt_value = stmt(ctx, token);
 
-      if (stmt_value == ERROR) {
+      if (ctx->failed) {
          return stmt_value;
       } else {
-         return stail(token, (subtotal * stmt_value));
+         return stail(ctx, token, (subtotal * stmt_value));
       }
    }
    //If the current token is the div opp, get the next token,
    //pass it to stmt and then recurse.
-   else if (strcmp(curr_cat, "DIV_OPP") == 0) {
-      mult_div_tok(token);
-      stmt_value = stmt(token);
+   else if (token->kind == DIV_OP) {
+      mult_div_tok(ctx, token);
+      stmt_value = stmt(ctx, token);
 
-      if (stmt_value == ERROR) {
+      if (ctx->failed) {
          return stmt_value;
       } else {
-         return stail(token, (subtotal / stmt_value));
+         return stail(ctx, token, int_divide(subtotal, stmt_value, &ctx->status));
       }
    }
    //If the current token is not the mult or div op
@@ -371,22 +413,109 @@ int stail(char * token, int subtotal) {
 
 /**
  * function to convert one or more ascii characters to integers
+ * @param ctx the line being read and the error state
  * @param token - the possible number
  * @return the integer value of the character
  */
-int num(char * token) {
+int num(context_t * ctx, token_t * token) {
    int value;
 
-   if (strcmp(curr_cat, "INT_LITERAL") == 0) {
-      value = (atoi(token));
-      if (!get_token(token)) {
-         return ERROR;
+   if (token->kind == INT_LITERAL) {
+      value = int_value(token);
+      if (!get_token(ctx, token)) {
+         return fail(ctx);
       }
    } else {
-      value = ERROR;
+      value = fail(ctx);
    }
    return value;
 }
 
 
+/**
+ * <name> ::=  {a-z | A-Z | _} {a-z | A-Z | _ | 0-9}*
+ * function to read the value of a variable
+ * @param ctx the line being read and the error state
+ * @param token the name
+ * @return the value of the variable
+ */
+int name(context_t * ctx, token_t * token) {
+   int slot = variable(ctx, token);
+
+   if (slot == NO_SLOT || !get_token(ctx, token)) {
+      return fail(ctx);
+   }
+   return ctx->symbols->values[slot];
+}
+
+/**
+ * Starts a statement of the form <name> = <expr> ; by giving the name a
+ * slot and moving past the '='. Every parser calls this first, so a
+ * statement that is not an assignment only costs a test of its first token.
+ * @param ctx the line being read and the error state, ctx->target is set
+ * @param token the first lexeme of the statement, left on the first one of
+ *              the expression. If the line ends at the '=' it stays an
+ *              ASSIGN_OP, which no expression starts with.
+ * @return the slot the statement assigns, or NO_SLOT if it assigns none
+ */
+int assignment(context_t * ctx, token_t * token) {
+   ctx->target = NO_SLOT;
+   if (token->kind != IDENTIFIER || !assignment_ahead(ctx)) {
+      return NO_SLOT;
+   }
+   ctx->target = symbols_intern(ctx->symbols, token->lexeme, token->length);
+   ctx->stateful = 1;
+   if (get_token(ctx, token)) {
+      get_token(ctx, token);
+   }
+   return ctx->target;
+}
+
+/**
+ * Checks the token after the expression of a statement. Any token ends
+ * it and a missing ';' is let go, but not an '=', since only a name can
+ * be assigned: "7 = 7;" is an error rather than two statements.
+ * @param ctx the line being read and the error state
+ * @param token the token after the expression
+ * @param parsed 1 if the expression was read, 0 if it already has an error
+ * @return 0 after reporting an '=' after a parsed expression, 1 otherwise
+ */
+int statement_end(context_t * ctx, token_t * token, int parsed) {
+   if (token->kind == SEMI_COLON) {
+      return 1;
+   }
+   strcpy(ctx->lex_error, ";");
+   ctx->syntax_error = 1;
+   if (token->kind != ASSIGN_OP || !parsed) {
+      return 1;
+   }
+   output_string(ctx->out, "===> ';' expected\nSyntax Error\n");
+   ctx->reported = 1;
+   return 0;
+}
+
+/**
+ * Finds the slot of a name read in an expression. Names are resolved
+ * while the statement is parsed, so evaluating one is an array load.
+ * @param ctx the line being read and the error state
+ * @param token the name
+ * @return its slot, or NO_SLOT after reporting a name that was never
+ *         given a value
+ */
+int variable(context_t * ctx, token_t * token) {
+   symbols_t *symbols = ctx->symbols;
+   int slot = symbols_find(symbols, token->lexeme, token->length);
 
+   ctx->stateful = 1;
+   if (slot != NO_SLOT && symbols->defined[slot]) {
+      return slot;
+   }
+   if (ctx->stats != NULL) {
+      ctx->stats->name_errors++;
+   }
+   output_string(ctx->out, "===> '");
+   output_write(ctx->out, token->lexeme, token->length);
+   output_string(ctx->out, "'\nName Error: not defined\n");
+   ctx->reported = 1;
+   return NO_SLOT;
+}
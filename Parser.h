@@ -1,32 +1,29 @@
 #ifndef PARSER_H
    #define PARSER_H
-#define ERROR -999999 // value to represent an error
 
-
-extern char * line; // the current line from the input file
-
-extern char curr_cat[OPSIZE]; //current token category
-
-extern FILE* out_file; // the file to write to
 /*
  * Purpose: Function Prototypes for parser.c
  * Date:    April 21, 2023
  */
-int bexpr(char *);	// bexpr is short for boolean_expression
-int expr(char *);     // expr is short for expression
-int term(char *);
-int ttail(char *, int);       // ttail is short for term_tail
-int stmt(char *);
-int stail(char *, int);      // stail is short for statement_tail
-int factor(char *);
-int ftail(char *, int);	// ftail is short for factor_tail
-int expp(char *);     // expp is short for exponentiation
+int bexpr(context_t *, token_t *);	// bexpr is short for boolean_expression
+int expr(context_t *, token_t *);     // expr is short for expression
+int term(context_t *, token_t *);
+int ttail(context_t *, token_t *, int);       // ttail is short for term_tail
+int stmt(context_t *, token_t *);
+int stail(context_t *, token_t *, int);      // stail is short for statement_tail
+int factor(context_t *, token_t *);
+int ftail(context_t *, token_t *, int);	// ftail is short for factor_tail
+int expp(context_t *, token_t *);     // expp is short for exponentiation
 
-void add_sub_tok(char *);
-void mul_div_tok(char *);
-void compare_tok(char *);
-void expon_tok(char *); // helper function
-int num(char *);
+void add_sub_tok(context_t *, token_t *);
+void mul_div_tok(context_t *, token_t *);
+void compare_tok(context_t *, token_t *);
+void expon_tok(context_t *, token_t *); // helper function
+int num(context_t *, token_t *);
+int name(context_t *, token_t *);
+int assignment(context_t *, token_t *); // the slot a statement assigns, or NO_SLOT
+int statement_end(context_t *, token_t *, int); // 0 if an '=' follows the expression
+int variable(context_t *, token_t *);   // the slot of a name that has a value
 
 
 #endif
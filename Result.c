@@ -0,0 +1,290 @@
+/**
+ * result.c - the binary result file of -b, and a reader for it.
+ *
+ * Instead of echoing each line and printing "Syntax OK" and "Value is"
+ * for each statement, -b writes one fixed-width record per statement:
+ * its line, its place on the line, how it ended and its value. A program
+ * that wants the values reads them where they are in the mapping instead
+ * of parsing text. Errors are rare and their messages vary, so a record
+ * of a statement that wrote one points at it, kept word for word in a
+ * section after the records. With the input file, that is enough to
+ * write the text output again byte for byte, which results_write does.
+ *
+ * A program that reads result files needs this file, Input.c and
+ * Output.c, and no other part of the interpreter.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Output.h"
+#include "Input.h"
+#include "Result.h"
+
+/* what the text output says after "Syntax OK" for RESULT_OVERFLOW to RESULT_TOO_LARGE */
+static const char *arith_errors[] = {
+    NULL,
+    "Arithmetic Error: overflow",
+    "Arithmetic Error: division by zero",
+    "Arithmetic Error: value too large"
+};
+
+/**
+ * Starts a result file: writes its header and keeps the messages in
+ * memory until the end.
+ *
+ * @param results the file being written
+ * @param out where it is written
+ */
+void results_init(results_t *results, output_t *out) {
+    result_header_t header;
+
+    memset(&header, 0, sizeof(result_header_t));
+    memcpy(header.magic, RESULT_MAGIC, 4);
+    header.version = RESULT_VERSION;
+    header.record_size = sizeof(result_record_t);
+    output_write(out, (const char *) &header, sizeof(result_header_t));
+
+    results->out = out;
+    output_memory(&results->messages);
+    results->start = 0;
+    results->line = 0;
+    results->statement = 0;
+    results->records = 0;
+}
+
+/**
+ * Moves on to the next line of the input.
+ *
+ * @param results the file being written
+ */
+void results_line(results_t *results) {
+    results->line++;
+    results->statement = 0;
+    results->start = results->messages.size;
+}
+
+/**
+ * Writes the record of the current statement and moves on to the next.
+ * Whatever was written to the messages since the statement started is
+ * its message: the errors of a statement that has no value, or the
+ * lexical errors the tokenizer skipped over in one that has.
+ *
+ * @param results the file being written
+ * @param status how the statement ended
+ * @param value its value, 0 without RESULT_VALUE
+ */
+void results_value(results_t *results, int status, long long value) {
+    result_record_t record;
+
+    record.message = RESULT_NO_MESSAGE;
+    if (results->messages.size > results->start) {
+        if (results->start >= RESULT_NO_MESSAGE) {
+            fprintf(stderr, "ERROR: too many error messages for a result file\n");
+            exit(1);
+        }
+        output_write(&results->messages, "", 1);
+        record.message = results->start;
+    }
+    record.line = results->line;
+    record.statement = results->statement++;
+    record.status = status;
+    record.value = value;
+    output_write(results->out, (const char *) &record, sizeof(result_record_t));
+    results->records++;
+    results->start = results->messages.size;
+}
+
+/**
+ * Writes the record of a statement that stopped at a lexical, syntax or
+ * name error, whose kind is that of the first message it wrote.
+ *
+ * @param results the file being written
+ */
+void results_error(results_t *results) {
+    const char *message = results->messages.data + results->start;
+    const char *kind = memchr(message, '\n', results->messages.size - results->start);
+    int status = RESULT_SYNTAX_ERROR;
+
+    if (kind != NULL && kind[1] == 'L') {
+        status = RESULT_LEXICAL_ERROR;
+    } else if (kind != NULL && kind[1] == 'N') {
+        status = RESULT_NAME_ERROR;
+    }
+    results_value(results, status, 0);
+}
+
+/**
+ * Ends a result file: writes the messages and the trailer.
+ *
+ * @param results the file being written
+ */
+void results_finish(results_t *results) {
+    result_trailer_t trailer;
+
+    memset(&trailer, 0, sizeof(result_trailer_t));
+    trailer.records = results->records;
+    trailer.messages = results->messages.size;
+    memcpy(trailer.magic, RESULT_MAGIC, 4);
+    output_write(results->out, results->messages.data, results->messages.size);
+    output_write(results->out, (const char *) &trailer, sizeof(result_trailer_t));
+    free(results->messages.data);
+    results->messages.data = NULL;
+}
+
+/**
+ * Maps a result file and checks that it is whole.
+ *
+ * @param file where its records and messages are found
+ * @param path the file
+ * @return 1 if successful, 0 if it cannot be read or is not a result file
+ */
+int results_open(result_file_t *file, const char *path) {
+    result_header_t header;
+    result_trailer_t trailer;
+    struct stat info;
+    size_t body;  // bytes of records and messages
+    void *map;
+    int fd = open(path, O_RDONLY);
+    long i;
+
+    memset(file, 0, sizeof(result_file_t));
+    if (fd < 0) {
+        return 0;
+    }
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)
+        || (size_t) info.st_size < sizeof(result_header_t) + sizeof(result_trailer_t)) {
+        close(fd);
+        return 0;
+    }
+    map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return 0;
+    }
+    file->data = map;
+    file->size = info.st_size;
+
+    memcpy(&header, file->data, sizeof(result_header_t));
+    memcpy(&trailer, file->data + file->size - sizeof(result_trailer_t), sizeof(result_trailer_t));
+    body = file->size - sizeof(result_header_t) - sizeof(result_trailer_t);
+    if (memcmp(header.magic, RESULT_MAGIC, 4) != 0 || header.version != RESULT_VERSION
+        || header.record_size != sizeof(result_record_t) || memcmp(trailer.magic, RESULT_MAGIC, 4) != 0
+        || trailer.records > body / sizeof(result_record_t)
+        || trailer.messages != body - trailer.records * sizeof(result_record_t)
+        || (trailer.messages > 0 && file->data[file->size - sizeof(result_trailer_t) - 1] != '\0')) {
+        results_close(file);
+        return 0;
+    }
+    file->records = (const result_record_t *) (file->data + sizeof(result_header_t));
+    file->count = trailer.records;
+    file->messages = (const char *) (file->records + file->count);
+    file->messages_size = trailer.messages;
+
+    for (i = 0; i < file->count; i++) {
+        if (file->records[i].message != RESULT_NO_MESSAGE
+            && file->records[i].message >= file->messages_size) {
+            results_close(file);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @param file a result file
+ * @param record one of its records
+ * @return the message of the record, or NULL if it has none
+ */
+const char *results_text(const result_file_t *file, const result_record_t *record) {
+    if (record->message == RESULT_NO_MESSAGE) {
+        return NULL;
+    }
+    return file->messages + record->message;
+}
+
+/**
+ * Writes what the text output has for one statement.
+ *
+ * @param file a result file
+ * @param record one of its records
+ * @param out where the text is written
+ */
+static void write_record(const result_file_t *file, const result_record_t *record, output_t *out) {
+    const char *message = results_text(file, record);
+    const char *digits = NULL;
+
+    if (record->status == RESULT_BIG && message != NULL) {
+        digits = strrchr(message, '\n');
+        digits = digits != NULL ? digits + 1 : message;
+        output_write(out, message, digits - message);
+    } else if (message != NULL) {
+        output_string(out, message);
+    }
+
+    switch (record->status) {
+    case RESULT_VALUE:
+        output_string(out, "Syntax OK\nValue is ");
+        output_long(out, record->value);
+        output_string(out, "\n");
+        break;
+    case RESULT_OVERFLOW:
+    case RESULT_DIVIDE_BY_ZERO:
+    case RESULT_TOO_LARGE:
+        output_string(out, "Syntax OK\n");
+        output_string(out, arith_errors[record->status]);
+        output_string(out, "\n");
+        break;
+    case RESULT_BIG:
+        output_string(out, "Syntax OK\nValue is ");
+        output_string(out, digits != NULL ? digits : "");
+        output_string(out, "\n");
+        break;
+    }
+}
+
+/**
+ * Writes the text output of a result file again: each line of the input
+ * that was run, then what its statements wrote.
+ *
+ * @param file a result file
+ * @param input the input it was written for
+ * @param out where the text is written
+ */
+void results_write(const result_file_t *file, input_t *input, output_t *out) {
+    const char *line;
+    size_t length;
+    uint32_t number = 0;
+    long i = 0;
+
+    while (input_next_line(input, &line, &length)) {
+        number++;
+        output_echo(out, line, length);
+        for (; i < file->count && file->records[i].line <= number; i++) {
+            write_record(file, &file->records[i], out);
+        }
+    }
+    //records of lines past the end of the input, if it is not the one that was run
+    for (; i < file->count; i++) {
+        write_record(file, &file->records[i], out);
+    }
+}
+
+/**
+ * Unmaps a result file.
+ *
+ * @param file the file
+ */
+void results_close(result_file_t *file) {
+    if (file->data != NULL) {
+        munmap((void *) file->data, file->size);
+    }
+    memset(file, 0, sizeof(result_file_t));
+}
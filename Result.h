@@ -0,0 +1,91 @@
+#ifndef RESULT_H
+   #define RESULT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define RESULT_MAGIC "IRES"  // starts the header and the trailer of a result file
+#define RESULT_VERSION 1
+#define RESULT_NO_MESSAGE UINT32_MAX
+
+/* how a statement ended; the arithmetic errors have the numbers of enum arith_status */
+enum result_status {
+    RESULT_VALUE,           // value holds its value
+    RESULT_OVERFLOW,
+    RESULT_DIVIDE_BY_ZERO,
+    RESULT_TOO_LARGE,
+    RESULT_BIG,             // a value of -a big too wide for 64 bits, the digits after the last '\n' of the message
+    RESULT_LEXICAL_ERROR,   // no value; the message is what the text output has for it
+    RESULT_SYNTAX_ERROR,
+    RESULT_NAME_ERROR
+};
+
+/*
+ * The start of a result file, in the byte order of the machine that
+ * wrote it. The records follow, then the messages, each '\0' terminated,
+ * then a result_trailer_t. The counts are at the end so the file can be
+ * written to a pipe as the lines are run.
+ */
+typedef struct result_header {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_size;  // sizeof(result_record_t)
+    uint32_t padding;
+} result_header_t;
+
+/*
+ * One statement. Any of them may have a message, which the text output
+ * has before "Syntax OK": a statement can have a value even though the
+ * tokenizer skipped over characters that are not lexemes in it.
+ */
+typedef struct result_record {
+    uint32_t line;       // the line it is on, from 1
+    uint32_t statement;  // which statement of the line it is, from 0
+    uint32_t status;     // enum result_status
+    uint32_t message;    // where its error messages start in the messages, or RESULT_NO_MESSAGE
+    int64_t value;       // its value with RESULT_VALUE, otherwise 0
+} result_record_t;
+
+typedef struct result_trailer {
+    uint64_t records;
+    uint64_t messages;   // bytes of messages
+    char magic[4];
+    uint32_t padding;
+} result_trailer_t;
+
+/* a result file being written */
+typedef struct results {
+    output_t *out;       // where the records go
+    output_t messages;   // the messages, in memory until the last record is written
+    size_t start;        // where the message of the current statement starts
+    uint32_t line;
+    uint32_t statement;
+    uint64_t records;
+} results_t;
+
+/* a result file that has been read, its records and messages in the mapping */
+typedef struct result_file {
+    const char *data;
+    size_t size;
+    const result_record_t *records;
+    long count;
+    const char *messages;
+    size_t messages_size;
+} result_file_t;
+
+/*
+ * Purpose: Function Prototypes for result.c
+ * Date:    October 17, 2026
+ */
+void results_init(results_t *results, output_t *out);
+void results_line(results_t *results);
+void results_value(results_t *results, int status, long long value);
+void results_error(results_t *results);
+void results_finish(results_t *results);
+int results_open(result_file_t *file, const char *path);
+const char *results_text(const result_file_t *file, const result_record_t *record);
+void results_write(const result_file_t *file, input_t *input, output_t *out);
+void results_close(result_file_t *file);
+
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * scan.c - the kernels behind scan_spaces and scan_digits.
+ *
+ * The vector kernels load whole aligned blocks, starting with the one the
+ * run starts in. An aligned load never crosses into another page, so
+ * reading past the '\n' or '\0' that ends the line is safe, though it is
+ * outside the line as far as AddressSanitizer knows; they are left out of
+ * its checks.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCAN_X86
+#endif
+
+#include "./Scan.h"
+
+#define NOT_CHECKED __attribute__((no_sanitize_address))
+
+
+/**
+ * Finds the end of a run of whitespace a byte at a time.
+ *
+ * @param p the start of the run
+ * @return its length
+ */
+static size_t spaces_scalar(const char *p) {
+    const char *q = p;
+
+    while (*q == ' ' || *q == '\t' || *q == '\r') {
+        q++;
+    }
+    return q - p;
+}
+
+/**
+ * Finds the end of a run of digits a byte at a time.
+ *
+ * @param p the start of the run
+ * @return its length
+ */
+static size_t digits_scalar(const char *p) {
+    const char *q = p;
+
+    while ((unsigned char) (*q - '0') <= 9) {
+        q++;
+    }
+    return q - p;
+}
+
+#ifdef SCAN_X86
+
+/**
+ * @param block 16 bytes
+ * @return a bit for each byte of the block that is not a space, tab or '\r'
+ */
+__attribute__((target("sse2")))
+static inline unsigned not_spaces_sse2(__m128i block) {
+    __m128i spaces = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')),
+                                               _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))),
+                                  _mm_cmpeq_epi8(block, _mm_set1_epi8('\r')));
+    return ~_mm_movemask_epi8(spaces) & 0xffff;
+}
+
+/**
+ * @param block 16 bytes
+ * @return a bit for each byte of the block that is not a digit
+ */
+__attribute__((target("sse2")))
+static inline unsigned not_digits_sse2(__m128i block) {
+    //a digit less '0' is at most 9 as an unsigned byte
+    __m128i offset = _mm_sub_epi8(block, _mm_set1_epi8('0'));
+    __m128i digits = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(9)), offset);
+    return ~_mm_movemask_epi8(digits) & 0xffff;
+}
+
+/**
+ * Finds the end of a run of whitespace 16 bytes at a time.
+ *
+ * @param p the start of the run
+ * @return its length
+ */
+__attribute__((target("sse2")))
+NOT_CHECKED static size_t spaces_sse2(const char *p) {
+    const char *block = (const char *) ((uintptr_t) p & ~(uintptr_t) 15);
+    //bytes of the first block that come before p do not count
+    unsigned ends = not_spaces_sse2(_mm_load_si128((const __m128i *) block)) & (0xffffu << (p - block));
+
+    while (ends == 0) {
+        block += 16;
+        ends = not_spaces_sse2(_mm_load_si128((const __m128i *) block));
+    }
+    return block + __builtin_ctz(ends) - p;
+}
+
+/**
+ * Finds the end of a run of digits 16 bytes at a time.
+ *
+ * @param p the start of the run
+ * @return its length
+ */
+__attribute__((target("sse2")))
+NOT_CHECKED static size_t digits_sse2(const char *p) {
+    const char *block = (const char *) ((uintptr_t) p & ~(uintptr_t) 15);
+    unsigned ends = not_digits_sse2(_mm_load_si128((const __m128i *) block)) & (0xffffu << (p - block));
+
+    while (ends == 0) {
+        block += 16;
+        ends = not_digits_sse2(_mm_load_si128((const __m128i *) block));
+    }
+    return block + __builtin_ctz(ends) - p;
+}
+
+/**
+ * @param block 32 bytes
+ * @return a bit for each byte of the block that is not a space, tab or '\r'
+ */
+__attribute__((target("avx2")))
+static inline uint32_t not_spaces_avx2(__m256i block) {
+    __m256i spaces = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')),
+                                                     _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t'))),
+                                     _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\r')));
+    return ~(uint32_t) _mm256_movemask_epi8(spaces);
+}
+
+/**
+ * @param block 32 bytes
+ * @return a bit for each byte of the block that is not a digit
+ */
+__attribute__((target("avx2")))
+static inline uint32_t not_digits_avx2(__m256i block) {
+    __m256i offset = _mm256_sub_epi8(block, _mm256_set1_epi8('0'));
+    __m256i digits = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(9)), offset);
+    return ~(uint32_t) _mm256_movemask_epi8(digits);
+}
+
+/**
+ * Finds the end of a run of whitespace 32 bytes at a time.
+ *
+ * @param p the start of the run
+ * @return its length
+ */
+__attribute__((target("avx2")))
+NOT_CHECKED static size_t spaces_avx2(const char *p) {
+    const char *block = (const char *) ((uintptr_t) p & ~(uintptr_t) 31);
+    uint32_t ends = not_spaces_avx2(_mm256_load_si256((const __m256i *) block)) & (0xffffffffu << (p - block));
+
+    while (ends == 0) {
+        block += 32;
+        ends = not_spaces_avx2(_mm256_load_si256((const __m256i *) block));
+    }
+    return block + __builtin_ctz(ends) - p;
+}
+
+/**
+ * Finds the end of a run of digits 32 bytes at a time.
+ *
+ * @param p the start of the run
+ * @return its length
+ */
+__attribute__((target("avx2")))
+NOT_CHECKED static size_t digits_avx2(const char *p) {
+    const char *block = (const char *) ((uintptr_t) p & ~(uintptr_t) 31);
+    uint32_t ends = not_digits_avx2(_mm256_load_si256((const __m256i *) block)) & (0xffffffffu << (p - block));
+
+    while (ends == 0) {
+        block += 32;
+        ends = not_digits_avx2(_mm256_load_si256((const __m256i *) block));
+    }
+    return block + __builtin_ctz(ends) - p;
+}
+
+#endif
+
+/* every set of kernels, the best first */
+static const scan_kernels_t kernels[] = {
+#ifdef SCAN_X86
+    {"avx2", spaces_avx2, digits_avx2},
+    {"sse2", spaces_sse2, digits_sse2},
+#endif
+    {"scalar", spaces_scalar, digits_scalar}
+};
+#define KERNELS ((int) (sizeof(kernels) / sizeof(kernels[0])))
+
+scan_kernels_t scan = {"scalar", spaces_scalar, digits_scalar};
+
+
+/**
+ * @param name the name of a set of kernels
+ * @return 1 if this processor can run them
+ */
+static int supported(const char *name) {
+#ifdef SCAN_X86
+    if (strcmp(name, "avx2") == 0) {
+        return __builtin_cpu_supports("avx2");
+    }
+    if (strcmp(name, "sse2") == 0) {
+        return __builtin_cpu_supports("sse2");
+    }
+#endif
+    return strcmp(name, "scalar") == 0;
+}
+
+/**
+ * Switches scan_spaces and scan_digits to a set of kernels. Only meant
+ * for benchmarks and before any other thread is scanning.
+ *
+ * @param name "avx2", "sse2" or "scalar", or NULL for the best one
+ * @return 1 if the kernels are in use, 0 if this processor cannot run them
+ */
+int scan_use(const char *name) {
+    int i;
+
+    for (i = 0; i < KERNELS; i++) {
+        if ((name == NULL || strcmp(name, kernels[i].name) == 0) && supported(kernels[i].name)) {
+            scan = kernels[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Picks the best kernels as the program starts.
+ */
+__attribute__((constructor))
+static void scan_init(void) {
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+#endif
+    scan_use(NULL);
+}
@@ -0,0 +1,53 @@
+#ifndef SCAN_H
+   #define SCAN_H
+
+#include <stddef.h>
+
+/*
+ * Finds where a run of whitespace or of digits ends, 16 or 32 bytes at a
+ * time on x86 and a byte at a time elsewhere. The kernels are picked once,
+ * as the program starts, from what the processor supports.
+ *
+ * The runs are the C_SPACE and C_DIGIT classes of tokenizer.c, and every
+ * line ends in '\n' or '\0', which is in neither, so a scan always stops
+ * inside the line. It may read the rest of the aligned block the end is in.
+ */
+typedef struct scan_kernels {
+    const char *name;
+    size_t (*spaces)(const char *p);
+    size_t (*digits)(const char *p);
+} scan_kernels_t;
+
+extern scan_kernels_t scan;
+
+/**
+ * @param p a space, tab or '\r'
+ * @return the number of them that p starts with
+ */
+static inline size_t scan_spaces(const char *p) {
+    //most runs are one space, which is not worth a call
+    if (p[1] != ' ' && p[1] != '\t' && p[1] != '\r') {
+        return 1;
+    }
+    return scan.spaces(p);
+}
+
+/**
+ * @param p a digit
+ * @return the number of digits p starts with
+ */
+static inline size_t scan_digits(const char *p) {
+    if ((unsigned char) (p[1] - '0') > 9) {
+        return 1;
+    }
+    return scan.digits(p);
+}
+
+/*
+ * Purpose: Function Prototypes for scan.c
+ * Date:    October 17, 2026
+ */
+int scan_use(const char *name);
+
+
+#endif
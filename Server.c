@@ -0,0 +1,258 @@
+/**
+ * server.c - answers statements sent over a Unix domain socket, so a
+ * program that evaluates many short expressions starts the interpreter
+ * once instead of once per expression.
+ *
+ * A request is a line, and its reply is what the line would write to the
+ * output file without the echo, followed by an empty line. No result or
+ * diagnostic is ever an empty line, so a client reads up to the first
+ * one. A client may send lines without waiting for their replies: they
+ * come back in order, written whenever no further whole line has arrived.
+ *
+ * Each connection has a thread and a worker of its own, so connections
+ * share nothing and run at the same time. That includes the variables: a
+ * client sees only what it assigned, for as long as it stays connected.
+ * Nothing a client sends may take the others down, so every worker parses
+ * with iterative.c and its -l limit instead of recursing as deep as a
+ * line nests.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "Library.h"
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Ast.h"
+#include "Big.h"
+#include "Arith.h"
+#include "Vm.h"
+#include "Iterative.h"
+#include "Cache.h"
+#include "Arena.h"
+#include "Stats.h"
+#include "Input.h"
+#include "Symbols.h"
+#include "Interpreter.h"
+
+/* a client being served */
+typedef struct connection {
+    int fd;
+    worker_t *settings;    // the engine and options the worker copies
+} connection_t;
+
+static volatile sig_atomic_t stopping; // set by SIGINT and SIGTERM
+static pthread_mutex_t counters = PTHREAD_MUTEX_INITIALIZER; // guards the counters of settings
+
+
+/**
+ * Stops accepting connections.
+ *
+ * @param signal the signal
+ */
+static void stop(int signal) {
+    (void) signal;
+    stopping = 1;
+}
+
+/**
+ * Sends bytes to a client, carrying on after partial sends.
+ *
+ * @param fd the connection
+ * @param bytes the bytes
+ * @param length the number of bytes
+ * @return 1 if they were all sent, 0 if the client has gone away
+ */
+static int send_all(int fd, const char *bytes, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, bytes, length, MSG_NOSIGNAL);
+
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return 0;
+        }
+        bytes += sent;
+        length -= sent;
+    }
+    return 1;
+}
+
+/**
+ * The body of a connection thread: answers lines until the client closes
+ * the connection.
+ *
+ * @param arg the connection
+ * @return NULL
+ */
+static void *serve(void *arg) {
+    connection_t *connection = arg;
+    worker_t worker;
+    input_t input;
+    output_t replies;      // replies not sent yet
+    const char *line;
+    size_t length;
+
+    output_memory(&replies);
+    worker_init(&worker, connection->settings->engine, &replies);
+    worker_settings(&worker, connection->settings);
+    worker.iterative = 1;
+    worker.echo = 0;
+    if (connection->settings->cache.max_bytes > 0) {
+        worker_cache(&worker, connection->settings->cache.max_bytes);
+    }
+
+    if (input_fd(&input, connection->fd)) {
+        while (input_next_line(&input, &line, &length)) {
+            run_line(&worker, line, length);
+            output_write(&replies, "\n", 1);
+            if (!input_ready(&input)) {
+                if (!send_all(connection->fd, replies.data, replies.size)) {
+                    replies.size = 0;
+                    break;
+                }
+                replies.size = 0;
+            }
+        }
+        send_all(connection->fd, replies.data, replies.size);
+        input_close(&input);
+    } else {
+        close(connection->fd);
+    }
+
+    pthread_mutex_lock(&counters);
+    connection->settings->cache.hits += worker.cache.hits;
+    connection->settings->cache.misses += worker.cache.misses;
+    connection->settings->statements += worker.statements;
+    connection->settings->errors += worker.errors;
+    connection->settings->arithmetic_errors += worker.arithmetic_errors;
+    if (worker.ctx.stats != NULL) {
+        stats_add(&connection->settings->stats, &worker.stats);
+    }
+    pthread_mutex_unlock(&counters);
+
+    worker_free(&worker);
+    output_close(&replies);
+    free(connection);
+    return NULL;
+}
+
+/**
+ * Tells a socket file left behind by a server that did not get to remove
+ * it from one a server is still listening on, or a file that is not a
+ * socket, neither of which may be removed.
+ *
+ * @param address the path of the socket file
+ * @return 1 if the path is a socket nothing is listening on
+ */
+static int stale_socket(const struct sockaddr_un *address) {
+    struct stat info;
+    int probe;
+    int stale;
+
+    if (lstat(address->sun_path, &info) != 0 || !S_ISSOCK(info.st_mode)) {
+        return 0;
+    }
+    probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    stale = probe >= 0 && connect(probe, (const struct sockaddr *) address, sizeof(*address)) != 0
+        && errno == ECONNREFUSED;
+    if (probe >= 0) {
+        close(probe);
+    }
+    return stale;
+}
+
+/**
+ * Listens on a Unix domain socket and serves every client that connects
+ * on a thread of its own, until SIGINT or SIGTERM. The socket file is
+ * removed at the end.
+ *
+ * @param settings a worker whose engine and options the connections use,
+ *                 each connection gets a cache of its size and adds its
+ *                 counters and stats to it
+ * @param path where the socket is created
+ */
+void run_server(worker_t * settings, const char * path) {
+    struct sockaddr_un address;
+    struct sigaction action;
+    sigset_t signals, old;
+    pthread_attr_t detached;
+    pthread_t id;
+    int listener;
+
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "ERROR: socket path %s is too long\n", path);
+        exit(1);
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener >= 0 && stale_socket(&address)) {
+        unlink(path);
+    }
+    if (listener < 0 || bind(listener, (struct sockaddr *) &address, sizeof(address)) != 0
+        || listen(listener, SOMAXCONN) != 0) {
+        fprintf(stderr, "ERROR: could not listen on %s\n", path);
+        exit(1);
+    }
+
+    //no SA_RESTART, so the signal ends a waiting accept
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    //connection threads block the signals, so they always reach accept
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_attr_init(&detached);
+    pthread_attr_setdetachstate(&detached, PTHREAD_CREATE_DETACHED);
+
+    while (!stopping) {
+        connection_t *connection;
+        int fd = accept(listener, NULL, NULL);
+
+        if (fd < 0) {
+            if (errno != EINTR && errno != ECONNABORTED) {
+                fprintf(stderr, "ERROR: could not accept a connection\n");
+                sleep(1);
+            }
+            continue;
+        }
+        connection = malloc(sizeof(connection_t));
+        if (connection == NULL) {
+            close(fd);
+            continue;
+        }
+        connection->fd = fd;
+        connection->settings = settings;
+
+        pthread_sigmask(SIG_BLOCK, &signals, &old);
+        if (pthread_create(&id, &detached, serve, connection) != 0) {
+            fprintf(stderr, "ERROR: could not start a connection thread\n");
+            close(fd);
+            free(connection);
+        }
+        pthread_sigmask(SIG_SETMASK, &old, NULL);
+    }
+
+    pthread_attr_destroy(&detached);
+    close(listener);
+    unlink(path);
+}
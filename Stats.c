@@ -0,0 +1,117 @@
+/**
+ * stats.c - the counters and phase times of --stats, and the JSON
+ * summary printed at the end of a run.
+ *
+ * Phase times come from stats_clock, which reads the time stamp counter
+ * where there is one. The summary gives them in ticks and in nanoseconds,
+ * converting with the ticks per nanosecond measured over the whole run.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "Tokenizer.h"
+#include "Stats.h"
+
+
+/**
+ * Clears the counters and notes when the run started.
+ *
+ * @param stats the stats
+ */
+void stats_init(stats_t *stats) {
+    memset(stats, 0, sizeof(stats_t));
+    clock_gettime(CLOCK_MONOTONIC, &stats->started);
+    stats->start = stats_clock();
+}
+
+/**
+ * Adds the counters and times of one worker to another's, keeping the
+ * larger of the depths.
+ *
+ * @param stats the stats to add to
+ * @param from the stats to add
+ */
+void stats_add(stats_t *stats, const stats_t *from) {
+    int i;
+
+    stats->lines += from->lines;
+    for (i = 0; i < TOKEN_KINDS; i++) {
+        stats->tokens[i] += from->tokens[i];
+    }
+    if (from->max_paren_depth > stats->max_paren_depth) {
+        stats->max_paren_depth = from->max_paren_depth;
+    }
+    if (from->max_stack > stats->max_stack) {
+        stats->max_stack = from->max_stack;
+    }
+    stats->lexical_errors += from->lexical_errors;
+    stats->syntax_errors += from->syntax_errors;
+    stats->name_errors += from->name_errors;
+    stats->arithmetic_errors += from->arithmetic_errors;
+    stats->depth_errors += from->depth_errors;
+    stats->read += from->read;
+    stats->lex += from->lex;
+    stats->run += from->run;
+    stats->run_write_ns += from->run_write_ns;
+}
+
+/**
+ * Prints one phase as an object of ticks and nanoseconds.
+ */
+static void phase(FILE *file, const char *name, double ticks, double ticks_per_ns, int last) {
+    fprintf(file, "    \"%s\": {\"ticks\": %.0f, \"ns\": %.0f}%s\n",
+            name, ticks, ticks / ticks_per_ns, last ? "" : ",");
+}
+
+/**
+ * Prints the stats as JSON. Parsing and evaluating are timed together,
+ * as the time lines ran less the time in get_token and in writes.
+ *
+ * @param file where to print them
+ * @param stats the stats of every worker
+ * @param statements statements that had a value
+ * @param errors lines that stopped at an error
+ * @param write_ns nanoseconds spent writing the output file
+ */
+void stats_report(FILE *file, const stats_t *stats, long statements, long errors, long long write_ns) {
+    struct timespec now;
+    double wall_ns, ticks_per_ns, parse_eval;
+    long total = 0;
+    int i;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    wall_ns = (now.tv_sec - stats->started.tv_sec) * 1e9 + (now.tv_nsec - stats->started.tv_nsec);
+    ticks_per_ns = wall_ns > 0 ? (stats_clock() - stats->start) / wall_ns : 1;
+    if (ticks_per_ns <= 0) {
+        ticks_per_ns = 1;
+    }
+    parse_eval = stats->run - stats->lex - stats->run_write_ns * ticks_per_ns;
+    if (parse_eval < 0) {
+        parse_eval = 0;
+    }
+
+    fprintf(file, "{\n  \"lines\": %ld,\n  \"statements\": %ld,\n", stats->lines, statements);
+    fprintf(file, "  \"tokens\": {\n");
+    for (i = 0; i < TOKEN_KINDS; i++) {
+        fprintf(file, "    \"%s\": %ld,\n", category_name(i), stats->tokens[i]);
+        total += stats->tokens[i];
+    }
+    fprintf(file, "    \"total\": %ld\n  },\n", total);
+    fprintf(file, "  \"max_paren_depth\": %d,\n  \"max_stack_bytes\": %zu,\n",
+            stats->max_paren_depth, stats->max_stack);
+    fprintf(file, "  \"errors\": {\n    \"lines\": %ld,\n    \"lexical\": %ld,\n    \"syntax\": %ld,\n"
+            "    \"name\": %ld,\n    \"arithmetic\": %ld,\n    \"depth\": %ld\n  },\n", errors,
+            stats->lexical_errors, stats->syntax_errors, stats->name_errors, stats->arithmetic_errors,
+            stats->depth_errors);
+    fprintf(file, "  \"phases\": {\n");
+    phase(file, "read", stats->read, ticks_per_ns, 0);
+    phase(file, "lex", stats->lex, ticks_per_ns, 0);
+    phase(file, "parse_eval", parse_eval, ticks_per_ns, 0);
+    phase(file, "write", write_ns * ticks_per_ns, ticks_per_ns, 1);
+    fprintf(file, "  },\n  \"wall_ns\": %.0f,\n  \"ticks_per_ns\": %.3f\n}\n", wall_ns, ticks_per_ns);
+}
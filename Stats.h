@@ -0,0 +1,59 @@
+#ifndef STATS_H
+   #define STATS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * What --stats counts. A worker only fills one in when its context points
+ * at it, so with --stats off the only cost is a test of that pointer in
+ * get_token and run_line. Times are in ticks of stats_clock.
+ */
+typedef struct stats {
+    long lines;                 // lines run, cache hits included
+    long tokens[TOKEN_KINDS];   // tokens the parsers were handed, by category
+    int paren_depth;            // parentheses open on the current line
+    int max_paren_depth;
+    uintptr_t stack_base;       // the stack pointer as the current line started
+    size_t max_stack;           // deepest the stack went below it in get_token
+    long lexical_errors;
+    long syntax_errors;
+    long name_errors;           // names read before they were given a value
+    long arithmetic_errors;     // overflow and division by zero in wider arith
+    long depth_errors;          // statements past the -l limit
+    uint64_t read;              // handing out lines
+    uint64_t lex;               // in get_token
+    uint64_t run;               // in run_line, which includes lex and some writes
+    long long run_write_ns;     // writes made while a line ran
+    uint64_t start;             // stats_clock when the stats were set up
+    struct timespec started;    // the same moment on the wall clock
+} stats_t;
+
+/**
+ * @return a time in ticks: cycles where the CPU has a time stamp counter,
+ *         nanoseconds elsewhere
+ */
+static inline uint64_t stats_clock(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + ts.tv_nsec;
+#endif
+}
+
+/*
+ * Purpose: Function Prototypes for stats.c
+ * Date:    October 17, 2026
+ */
+void stats_init(stats_t *stats);
+void stats_add(stats_t *stats, const stats_t *from);
+void stats_report(FILE *file, const stats_t *stats, long statements, long errors, long long write_ns);
+
+
+#endif
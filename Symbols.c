@@ -0,0 +1,237 @@
+/**
+ * symbols.c - the names of variables and the slots they were given.
+ *
+ * Names are only looked up while a statement is parsed. The table keeps
+ * the hash of each name next to its slot, so a probe compares names only
+ * when the hashes match, and stays at most half full, so a lookup rarely
+ * looks at more than one bucket.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./Output.h"
+#include "./Symbols.h"
+
+#define SYMBOL_BUCKETS 64 // buckets of an empty table, doubled as it fills
+
+
+/**
+ * Sets up a table without any names.
+ *
+ * @param symbols the table
+ */
+void symbols_init(symbols_t *symbols) {
+    memset(symbols, 0, sizeof(symbols_t));
+}
+
+/**
+ * Frees the table.
+ *
+ * @param symbols the table
+ */
+void symbols_free(symbols_t *symbols) {
+    free(symbols->buckets);
+    free(symbols->names);
+    free(symbols->slots);
+    free(symbols->values);
+    free(symbols->wide);
+    free(symbols->defined);
+    symbols_init(symbols);
+}
+
+/**
+ * Forgets every name, keeping the memory.
+ *
+ * @param symbols the table
+ */
+void symbols_reset(symbols_t *symbols) {
+    int i;
+
+    for (i = 0; i < symbols->bucket_count; i++) {
+        symbols->buckets[i].slot = NO_SLOT;
+    }
+    symbols->names_size = 0;
+    symbols->count = 0;
+}
+
+/**
+ * Hashes a name with FNV-1a, which is quick on strings this short.
+ *
+ * @param name the name
+ * @param length its number of bytes
+ * @return the hash
+ */
+static uint32_t hash_name(const char *name, int length) {
+    uint32_t hash = 2166136261u;
+    int i;
+
+    for (i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char) name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Finds the bucket a name is in, or the empty one it would go in.
+ *
+ * @param symbols the table, which has buckets
+ * @param name the name
+ * @param length its number of bytes
+ * @param hash hash_name of the name
+ * @return the bucket
+ */
+static symbol_bucket_t *probe(const symbols_t *symbols, const char *name, int length, uint32_t hash) {
+    int mask = symbols->bucket_count - 1;
+    int i = hash & mask;
+
+    for (;;) {
+        symbol_bucket_t *bucket = &symbols->buckets[i];
+
+        if (bucket->slot == NO_SLOT) {
+            return bucket;
+        }
+        if (bucket->hash == hash && symbols->slots[bucket->slot].length == length
+            && memcmp(symbols->names + symbols->slots[bucket->slot].start, name, length) == 0) {
+            return bucket;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+/**
+ * Doubles the buckets and puts every slot back in them.
+ *
+ * @param symbols the table
+ */
+static void grow_buckets(symbols_t *symbols) {
+    int count = symbols->bucket_count ? 2 * symbols->bucket_count : SYMBOL_BUCKETS;
+    symbol_bucket_t *buckets = malloc(count * sizeof(symbol_bucket_t));
+    int slot;
+    int i;
+
+    if (buckets == NULL) {
+        out_of_memory("ERROR: out of memory for variables");
+    }
+    free(symbols->buckets);
+    symbols->buckets = buckets;
+    symbols->bucket_count = count;
+    for (i = 0; i < count; i++) {
+        symbols->buckets[i].slot = NO_SLOT;
+    }
+    for (slot = 0; slot < symbols->count; slot++) {
+        const char *name = symbols->names + symbols->slots[slot].start;
+        int length = symbols->slots[slot].length;
+        uint32_t hash = hash_name(name, length);
+        symbol_bucket_t *bucket = probe(symbols, name, length, hash);
+
+        bucket->hash = hash;
+        bucket->slot = slot;
+    }
+}
+
+/**
+ * Makes room for one more slot in every array.
+ *
+ * @param symbols the table
+ */
+static void grow_slots(symbols_t *symbols) {
+    int capacity = symbols->capacity ? 2 * symbols->capacity : SYMBOL_BUCKETS / 2;
+    void *grown;
+
+    //each array keeps what it had if a later one cannot grow
+    if ((grown = realloc(symbols->slots, capacity * sizeof(symbol_name_t))) == NULL) {
+        out_of_memory("ERROR: out of memory for variables");
+    }
+    symbols->slots = grown;
+    if ((grown = realloc(symbols->values, capacity * sizeof(int))) == NULL) {
+        out_of_memory("ERROR: out of memory for variables");
+    }
+    symbols->values = grown;
+    if ((grown = realloc(symbols->wide, capacity * sizeof(long long))) == NULL) {
+        out_of_memory("ERROR: out of memory for variables");
+    }
+    symbols->wide = grown;
+    if ((grown = realloc(symbols->defined, capacity)) == NULL) {
+        out_of_memory("ERROR: out of memory for variables");
+    }
+    symbols->defined = grown;
+    symbols->capacity = capacity;
+}
+
+/**
+ * Finds the slot of a name without adding it.
+ *
+ * @param symbols the table
+ * @param name the name, which need not be '\0' terminated
+ * @param length its number of bytes
+ * @return its slot, or NO_SLOT if it has never been interned
+ */
+int symbols_find(const symbols_t *symbols, const char *name, int length) {
+    if (symbols->count == 0) {
+        return NO_SLOT;
+    }
+    return probe(symbols, name, length, hash_name(name, length))->slot;
+}
+
+/**
+ * Finds the slot of a name, giving it the next one if it has none. A new
+ * slot is not defined until something is assigned to it.
+ *
+ * @param symbols the table
+ * @param name the name, which need not be '\0' terminated
+ * @param length its number of bytes
+ * @return its slot
+ */
+int symbols_intern(symbols_t *symbols, const char *name, int length) {
+    uint32_t hash = hash_name(name, length);
+    symbol_bucket_t *bucket;
+    int slot;
+
+    if (2 * (symbols->count + 1) > symbols->bucket_count) {
+        grow_buckets(symbols);
+    }
+    bucket = probe(symbols, name, length, hash);
+    if (bucket->slot != NO_SLOT) {
+        return bucket->slot;
+    }
+
+    if (symbols->count == symbols->capacity) {
+        grow_slots(symbols);
+    }
+    if (symbols->names_size + length > symbols->names_capacity) {
+        size_t capacity = 2 * (symbols->names_size + length);
+        char *names = realloc(symbols->names, capacity);
+
+        if (names == NULL) {
+            out_of_memory("ERROR: out of memory for variables");
+        }
+        symbols->names = names;
+        symbols->names_capacity = capacity;
+    }
+    slot = symbols->count++;
+    memcpy(symbols->names + symbols->names_size, name, length);
+    symbols->slots[slot].start = symbols->names_size;
+    symbols->slots[slot].length = length;
+    symbols->names_size += length;
+    symbols->values[slot] = 0;
+    symbols->wide[slot] = 0;
+    symbols->defined[slot] = 0;
+    bucket->hash = hash;
+    bucket->slot = slot;
+    return slot;
+}
+
+/**
+ * @param symbols the table
+ * @param slot a slot that has been handed out
+ * @param length set to the number of bytes in its name
+ * @return its name, not '\0' terminated
+ */
+const char *symbols_name(const symbols_t *symbols, int slot, int *length) {
+    *length = symbols->slots[slot].length;
+    return symbols->names + symbols->slots[slot].start;
+}
@@ -0,0 +1,54 @@
+#ifndef SYMBOLS_H
+   #define SYMBOLS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define NO_SLOT -1 // slot of a name that has never been assigned
+
+/* a bucket of the hash table, which holds the slot a name was given */
+typedef struct symbol_bucket {
+    uint32_t hash;
+    int slot;      // NO_SLOT if the bucket is empty
+} symbol_bucket_t;
+
+/* where the name of a slot is kept */
+typedef struct symbol_name {
+    int start;     // offset in names
+    int length;
+} symbol_name_t;
+
+/*
+ * The variables of a worker. Each name is interned the first time it is
+ * assigned and given the next slot, and the parsers resolve every name to
+ * its slot, so evaluating a variable is a load from values. The values
+ * of each slot are kept in arrays of their own: values in int arithmetic,
+ * wide in checked arithmetic, and big values in the registers of arith.c.
+ */
+typedef struct symbols {
+    symbol_bucket_t *buckets; // open addressing with linear probing
+    int bucket_count;         // a power of two, more than twice count
+    char *names;              // every name, one after the other
+    size_t names_size;
+    size_t names_capacity;
+    symbol_name_t *slots;     // the name of each slot
+    int *values;
+    long long *wide;
+    unsigned char *defined;   // 1 once an assignment to the slot has finished
+    int count;                // slots handed out
+    int capacity;             // slots there is room for in each array
+} symbols_t;
+
+/*
+ * Purpose: Function Prototypes for symbols.c
+ * Date:    October 17, 2026
+ */
+void symbols_init(symbols_t *symbols);
+void symbols_free(symbols_t *symbols);
+void symbols_reset(symbols_t *symbols);
+int symbols_find(const symbols_t *symbols, const char *name, int length);
+int symbols_intern(symbols_t *symbols, const char *name, int length);
+const char *symbols_name(const symbols_t *symbols, int slot, int *length);
+
+
+#endif
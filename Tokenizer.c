@@ -10,282 +10,374 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-
-#include "./tokenizer.h"
-#include "./parser.h"
-
-// Global pointer to line of input
-char *line;
-
-// index of where we are in the line
-int line_index;
-
-// The current category
-char curr_cat[OPSIZE];
-
-// the file to write to from parser.c
-extern FILE* out_file;
+#include <limits.h>
+#include <stdint.h>
+
+#include "./Tokenizer.h"
+#include "./Output.h"
+#include "./Context.h"
+#include "./Arena.h"
+#include "./Stats.h"
+#include "./Scan.h"
+#include "./Parser.h"
+
+
+/* Category names, indexed by enum token_kind. Only used for diagnostics. */
+static const char *category_names[] = {
+    "ADD_OP",
+    "SUB_OP",
+    "MULT_OP",
+    "DIV_OP",
+    "LEFT_PAREN",
+    "RIGHT_PAREN",
+    "EXPON_OP",
+    "LESS_THEN_OP",
+    "LESS_THEN_OR_EQUAL_OP",
+    "GREATER_THEN_OP",
+    "GREATER_THEN_OR_EQUAL_OP",
+    "EQUALS_OP",
+    "NOT_EQUALS_OP",
+    "SEMI_COLON",
+    "INT_LITERAL",
+    "IDENTIFIER",
+    "ASSIGN_OP",
+    "NOT_A_TOKEN"
+};
+
+
+
+/* Classes of input characters, used to index the transition table */
+enum char_class {
+    C_OTHER,
+    C_SPACE,
+    C_END,
+    C_DIGIT,
+    C_LETTER,
+    C_PLUS,
+    C_MINUS,
+    C_STAR,
+    C_SLASH,
+    C_LPAREN,
+    C_RPAREN,
+    C_CARET,
+    C_LESS,
+    C_GREATER,
+    C_EQUAL,
+    C_BANG,
+    C_SEMI,
+    C_CLASSES
+};
+
+/* Class of every possible input byte, anything not listed is C_OTHER */
+static const unsigned char char_class[256] = {
+    ['\0'] = C_END, ['\n'] = C_END,
+    [' '] = C_SPACE, ['\t'] = C_SPACE, ['\r'] = C_SPACE,
+    ['0'] = C_DIGIT, ['1'] = C_DIGIT, ['2'] = C_DIGIT, ['3'] = C_DIGIT,
+    ['4'] = C_DIGIT, ['5'] = C_DIGIT, ['6'] = C_DIGIT, ['7'] = C_DIGIT,
+    ['8'] = C_DIGIT, ['9'] = C_DIGIT,
+    ['A'] = C_LETTER, ['B'] = C_LETTER, ['C'] = C_LETTER, ['D'] = C_LETTER, ['E'] = C_LETTER, ['F'] = C_LETTER, ['G'] = C_LETTER,
+    ['H'] = C_LETTER, ['I'] = C_LETTER, ['J'] = C_LETTER, ['K'] = C_LETTER, ['L'] = C_LETTER, ['M'] = C_LETTER, ['N'] = C_LETTER,
+    ['O'] = C_LETTER, ['P'] = C_LETTER, ['Q'] = C_LETTER, ['R'] = C_LETTER, ['S'] = C_LETTER, ['T'] = C_LETTER, ['U'] = C_LETTER,
+    ['V'] = C_LETTER, ['W'] = C_LETTER, ['X'] = C_LETTER, ['Y'] = C_LETTER, ['Z'] = C_LETTER,
+    ['a'] = C_LETTER, ['b'] = C_LETTER, ['c'] = C_LETTER, ['d'] = C_LETTER, ['e'] = C_LETTER, ['f'] = C_LETTER, ['g'] = C_LETTER,
+    ['h'] = C_LETTER, ['i'] = C_LETTER, ['j'] = C_LETTER, ['k'] = C_LETTER, ['l'] = C_LETTER, ['m'] = C_LETTER, ['n'] = C_LETTER,
+    ['o'] = C_LETTER, ['p'] = C_LETTER, ['q'] = C_LETTER, ['r'] = C_LETTER, ['s'] = C_LETTER, ['t'] = C_LETTER, ['u'] = C_LETTER,
+    ['v'] = C_LETTER, ['w'] = C_LETTER, ['x'] = C_LETTER, ['y'] = C_LETTER, ['z'] = C_LETTER, ['_'] = C_LETTER,
+    ['+'] = C_PLUS, ['-'] = C_MINUS, ['*'] = C_STAR, ['/'] = C_SLASH,
+    ['('] = C_LPAREN, [')'] = C_RPAREN, ['^'] = C_CARET,
+    ['<'] = C_LESS, ['>'] = C_GREATER, ['='] = C_EQUAL, ['!'] = C_BANG,
+    [';'] = C_SEMI
+};
+
+/* States of the lexer, every state but S_START is part way through a token */
+enum lex_state {
+    S_START,
+    S_INT,
+    S_NAME,
+    S_LESS,
+    S_GREATER,
+    S_EQUAL,
+    S_BANG,
+    S_STATES
+};
+
+/*
+ * Entries of the transition table are either the next state, which consumes
+ * the current character, or one of the actions below.
+ * A(kind) accepts a token of that kind that ends with the current character,
+ * B(kind) accepts a token of that kind that ended just before it.
+ */
+#define A(kind) (S_STATES + (kind))
+#define B(kind) (S_STATES + TOKEN_KINDS + (kind))
+#define END (S_STATES + 2 * TOKEN_KINDS)
+
+/* Short names for the accepting entries that fill most of the table */
+#define INT B(INT_LITERAL)
+#define ID B(IDENTIFIER)
+#define LT B(LESS_THEN_OP)
+#define GT B(GREATER_THEN_OP)
+#define EQ B(ASSIGN_OP)
+#define BAD B(NOT_A_TOKEN)
+
+static const unsigned char transitions[S_STATES][C_CLASSES] = {
+    /*             OTHER           SPACE    END  DIGIT   LETTER  PLUS       MINUS      STAR        SLASH */
+    /*             LPAREN         RPAREN          CARET        LESS    GREATER    EQUAL                        BANG    SEMI */
+    [S_START]   = {A(NOT_A_TOKEN), S_START, END, S_INT,  S_NAME, A(ADD_OP), A(SUB_OP), A(MULT_OP), A(DIV_OP),
+                   A(LEFT_PAREN), A(RIGHT_PAREN), A(EXPON_OP), S_LESS, S_GREATER, S_EQUAL,                     S_BANG, A(SEMI_COLON)},
+    [S_INT]     = {INT,            INT,     INT, S_INT,  INT,    INT,       INT,       INT,        INT,
+                   INT,           INT,            INT,         INT,    INT,       INT,                         INT,    INT},
+    [S_NAME]    = {ID,             ID,      ID,  S_NAME, S_NAME, ID,        ID,        ID,         ID,
+                   ID,            ID,             ID,          ID,     ID,        ID,                          ID,     ID},
+    [S_LESS]    = {LT,             LT,      LT,  LT,     LT,     LT,        LT,        LT,         LT,
+                   LT,            LT,             LT,          LT,     LT,        A(LESS_THEN_OR_EQUAL_OP),    LT,     LT},
+    [S_GREATER] = {GT,             GT,      GT,  GT,     GT,     GT,        GT,        GT,         GT,
+                   GT,            GT,             GT,          GT,     GT,        A(GREATER_THEN_OR_EQUAL_OP), GT,     GT},
+    [S_EQUAL]   = {EQ,             EQ,      EQ,  EQ,     EQ,     EQ,        EQ,        EQ,         EQ,
+                   EQ,            EQ,             EQ,          EQ,     EQ,        A(EQUALS_OP),                EQ,     EQ},
+    [S_BANG]    = {BAD,            BAD,     BAD, BAD,    BAD,    BAD,       BAD,       BAD,        BAD,
+                   BAD,           BAD,            BAD,         BAD,    BAD,       A(NOT_EQUALS_OP),            BAD,    BAD}
+};
+
+#undef INT
+#undef ID
+#undef LT
+#undef GT
+#undef EQ
+#undef BAD
 
 
 
 /**
- * @brief Function for retrieving individual tokens.
- * Internally calls classify_token to immediately identify each token before the next iteration
- * 
+ * @brief Runs the transition table over the line from line_index,
+ * skipping leading whitespace, until a token is accepted. The token
+ * points into the line, nothing is copied.
+ *
+ * @param ctx the line being read and where to report errors
  * @param token a pointer to where the current token will be stored
+ * @return 0 if the end of the line or a lexical error was reached, 1 otherwise
  */
-int get_token(char *token) {
-    static int lex_error = 0;
-    // printf("getting token\n");
-    //skip all whitespace
-    while(line[line_index] == ' ' ||
-    line[line_index] == '\t' ||
-    line[line_index] == '\n' ||
-    line[line_index] == '\r'){
+static inline int next_token(context_t *ctx, token_t *token) {
+    const char *line = ctx->line;
+    int line_index = ctx->line_index;
+    int state = S_START;
+    int start;
+    int action;
+
+    //runs of whitespace and digits are found a block at a time, the
+    //table only sees where they end
+    if (char_class[(unsigned char) line[line_index]] == C_SPACE) {
+        line_index += scan_spaces(line + line_index);
+    }
+    start = line_index;
+    if (char_class[(unsigned char) line[line_index]] == C_DIGIT) {
+        line_index += scan_digits(line + line_index);
+        state = S_INT;
+    }
+
+    //one pass over the characters of the token
+    while ((action = transitions[state][char_class[(unsigned char) line[line_index]]]) < S_STATES) {
         line_index++;
+        if (action == S_START) {
+            //still skipping whitespace
+            start = line_index;
+        }
+        state = action;
     }
 
-    if (line[line_index] == '\0') {
+    if (action == END) {
+        ctx->line_index = line_index;
         return 0;
     }
 
-    classify_token(token);
-
-    //clear white space after a token as well
-    while(line[line_index] == ' ' ||
-    line[line_index] == '\t' ||
-    line[line_index] == '\n' ||
-    line[line_index] == '\r'){
+    if (action < B(0)) {
+        //the current character is the last one of the token
         line_index++;
+        token->kind = action - A(0);
+    } else {
+        token->kind = action - B(0);
     }
+    token->lexeme = line + start;
+    token->length = line_index - start;
+    ctx->line_index = line_index;
 
-    if(strcmp(curr_cat, "NOT_A_TOKEN") == 0 && lex_error != 1) {
-        lex_error = 1;
+    if(token->kind == NOT_A_TOKEN && ctx->in_lex_error != 1) {
+        ctx->in_lex_error = 1;
         char* error;
-        while(lex_error) {
-            error = get_lex_error(token, &lex_error);
+        while(ctx->in_lex_error) {
+            error = get_lex_error(ctx, token, &ctx->in_lex_error);
+        }
+        if (ctx->stats != NULL) {
+            //each character that is not a lexeme is a token of its own
+            ctx->stats->lexical_errors++;
+            ctx->stats->tokens[NOT_A_TOKEN] += strlen(error);
         }
-        fprintf(out_file, "===> '%s'\nLexical Error: not a lexeme\n", error);
+        output_string(ctx->out, "===> '");
+        output_string(ctx->out, error);
+        output_string(ctx->out, "'\nLexical Error: not a lexeme\n");
+        ctx->reported = 1;
         return 0;
     }
     return 1;
 }
 
-
 /**
- * @brief Recieves a token pointer and identifies the token
- * Sets the global variable curr_cat to the appropriate name
- * depending on the category of the current token
- * 
+ * @brief next_token for --stats: times it, counts the token it returns,
+ * and notes how deep the parentheses and the stack are, since every
+ * parser calls get_token at the bottom of its descent.
+ *
+ * @param ctx the line being read and where to report errors
  * @param token a pointer to where the current token will be stored
+ * @return what next_token returns
  */
-void classify_token(char* token) {
-    memset(token, 0, TSIZE);
-    memset(curr_cat, 0, OPSIZE);
-
-    //Plus op case
-    if (line[line_index] == '+'){
-        single_token(token, line[line_index]);
-        strcpy(curr_cat, "ADD_OP");
-    }
-        //Minus op case
-    else if (line[line_index] == '-'){
-        single_token(token, line[line_index]);
-        strcpy(curr_cat, "SUB_OP");
-    }
-        //Multiply op case
-    else if (line[line_index] == '*'){
-        single_token(token, line[line_index]);
-        strcpy(curr_cat, "MULT_OP");
+static int counted_token(context_t *ctx, token_t *token) {
+    stats_t *stats = ctx->stats;
+    uintptr_t here = (uintptr_t) __builtin_frame_address(0);
+    uint64_t start = stats_clock();
+    int result = next_token(ctx, token);
+
+    stats->lex += stats_clock() - start;
+    if (stats->stack_base > here && stats->stack_base - here > stats->max_stack) {
+        stats->max_stack = stats->stack_base - here;
     }
-        //Division op case
-    else if (line[line_index] == '/'){
-        single_token(token, line[line_index]);
-        strcpy(curr_cat, "DIV_OPP");
-    }
-        //Left paren case
-    else if (line[line_index] == '('){
-        single_token(token, line[line_index]);
-        strcpy(curr_cat, "LEFT_PAREN");
-    }
-        //Right paren case
-    else if (line[line_index] == ')'){
-        single_token(token, line[line_index]);
-        strcpy(curr_cat, "RIGHT_PAREN");
-    }
-        //Exponent op case
-    else if (line[line_index] == '^'){
-        single_token(token, line[line_index]);
-        strcpy(curr_cat, "EXPON_OP");
-    }
-        //2 cases
-    else if (line[line_index] == '<'){
-        //Less then or equal case
-        if(line[line_index + 1] == '='){
-            two_token(token, line[line_index], line[line_index + 1]);
-            strcpy(curr_cat, "LESS_THEN_OR_EQUAL_OP");
-        }
-            //Less than case
-        else{
-            single_token(token, line[line_index]);
-            strcpy(curr_cat, "LESS_THEN_OP");
+    if (result) {
+        stats->tokens[token->kind]++;
+        if (token->kind == LEFT_PAREN && ++stats->paren_depth > stats->max_paren_depth) {
+            stats->max_paren_depth = stats->paren_depth;
+        } else if (token->kind == RIGHT_PAREN) {
+            stats->paren_depth--;
         }
     }
-        //2 cases
-    else if (line[line_index] == '>'){
-        //Greater then or equal case
-        if(line[line_index + 1] == '='){
-            two_token(token, line[line_index], line[line_index + 1]);
-            strcpy(curr_cat, "GREATER_THEN_OR_EQUAL_OP");
-        }
-            //Greater then case.
-        else{
-            single_token(token, line[line_index]);
-            strcpy(curr_cat, "GREATER_THEN_OP");
-        }
-    }
-        //2 cases
-    else if (line[line_index] == '='){
-        //Equals op case.
-        if(line[line_index + 1] == '='){
-            two_token(token, line[line_index], line[line_index + 1]);
-            strcpy(curr_cat, "EQUALS_OP");
-        }
-            //Assignment op case.
-        else{
-            single_token(token, line[line_index]);
-            strcpy(curr_cat, "NOT_A_TOKEN");
-        }
-    }
-        //2 cases
-    else if (line[line_index] == '!'){
-        //not equals case
-        if(line[line_index + 1] == '='){
-            two_token(token, line[line_index], line[line_index + 1]);
-            strcpy(curr_cat, "NOT_EQUALS_OP");
-        }
-        //not case
-        else{
-            single_token(token, line[line_index]);
-            strcpy(curr_cat, "NOT_A_TOKEN");
-        }
-    }
-        //Semi Colon Case
-    else if (line[line_index] == ';'){
-        single_token(token, line[line_index]);
-        strcpy(curr_cat, "SEMI_COLON");
-    }
-        //Int literal case.
-    else if (is_int(line[line_index]) == 1){
-        make_int(token);//Construct the int
-        strcpy(curr_cat, "INT_LITERAL");
-    }
-        //Not a token case.
-    else{
-        single_token(token, line[line_index]);
-        strcpy(curr_cat, "NOT_A_TOKEN");
-    }
+    return result;
 }
 
 /**
- * @brief 'Creates' a token of length 1, adding a null terminator to
- * the end of the string
- * 
+ * @brief Function for retrieving individual tokens.
+ * Runs the transition table over the line from line_index, skipping
+ * leading whitespace, until a token is accepted. The token points into
+ * the line, nothing is copied.
+ *
+ * @param ctx the line being read and where to report errors
  * @param token a pointer to where the current token will be stored
- * @param token_char the character to be made into a token
+ * @return 0 if the end of the line or a lexical error was reached, 1 otherwise
  */
-void single_token(char *token, char token_char) {
-    token[0] = token_char;
-    token[1] = '\0';
-
-    line_index++;
+int get_token(context_t *ctx, token_t *token) {
+    if (ctx->stats == NULL) {
+        return next_token(ctx, token);
+    }
+    return counted_token(ctx, token);
 }
 
 /**
- * @brief 'Creates' a token of length 2, adding a null terminator to
- * the end of the string
- * 
- * @param token a pointer to where the current token will be stored
- * @param token_char the first character to be made into a token
- * @param token_char2 the second character to be made into a token
+ * @brief Skips any whitespace at line_index and reports whether
+ * the rest of the line is empty. A line of nothing but whitespace has no
+ * statements, so it writes no error, whatever the line before it ended in.
+ *
+ * @param ctx the line being read
+ * @return 1 if there are no more tokens on the line, 0 otherwise
  */
-void two_token(char token[TSIZE], char token_char1, char token_char2) {
-    token[0] = token_char1;//Assign first character in the token.
-    token[1] = token_char2;//Assign second character in the token.
-    token[2] = '\0';
-
-    line_index += 2;//Increment the line index by 2, the length of the token.
+int at_line_end(context_t *ctx) {
+    if (char_class[(unsigned char) ctx->line[ctx->line_index]] == C_SPACE) {
+        ctx->line_index += scan_spaces(ctx->line + ctx->line_index);
+    }
+    return char_class[(unsigned char) ctx->line[ctx->line_index]] == C_END;
 }
 
 /**
- * @brief Checks if a character could possibly be an int literal
- * 
- * @param pos_int the character to be checked
+ * @brief Looks past whitespace for an '=' that is not part of "==",
+ * without reading a token, so a statement can tell an assignment from an
+ * expression that starts with a name
+ *
+ * @param ctx the line being read, just after a name
+ * @return 1 if the next token is an ASSIGN_OP, 0 otherwise
  */
-int is_int(char pos_int) {
-    int flag = 0;
-
-    if (pos_int == '0' ||
-        pos_int == '1' ||
-        pos_int == '2' ||
-        pos_int == '3' ||
-        pos_int == '4' ||
-        pos_int == '5' ||
-        pos_int == '6' ||
-        pos_int == '7' ||
-        pos_int == '8' ||
-        pos_int == '9'){
-
-        //set flag to 1 (true) if the token is an int
-        flag = 1;
-    }
+int assignment_ahead(context_t *ctx) {
+    const char *p = ctx->line + ctx->line_index;
 
-    return flag;
+    while (char_class[(unsigned char) *p] == C_SPACE) {
+        p++;
+    }
+    return p[0] == '=' && p[1] != '=';
 }
 
 /**
- * @brief Creates an int literal as a token, accounting
- * for an int containing any number of digits
- * 
- * @param token_ptr a pointer to where the current token will be stored
+ * @brief Tells whether running a line can read or assign a variable,
+ * without reading its tokens or reporting anything. A LETTER is always
+ * part of an IDENTIFIER: S_START goes to S_NAME on one, and every other
+ * state but S_NAME accepts its token before it, so a lexical error never
+ * takes one in. Looking for the class is enough.
+ *
+ * @param line a line that ends at its '\n' or a '\0'
+ * @return 1 if the line has an IDENTIFIER, 0 otherwise
  */
-void make_int(char token_ptr[TSIZE]) {
+int has_identifier(const char *line) {
+    const unsigned char *p = (const unsigned char *) line;
 
-    //Assign the int character to
-    //the first element of token.
-    token_ptr[0] = line[line_index];
-
-    //Used to keep track of how long the int token is.
-    int int_count = 1;
+    while (char_class[*p] != C_END) {
+        if (char_class[*p++] == C_LETTER) {
+            return 1;
+        }
+    }
+    return 0;
+}
 
-    //While the next character in line is an in,
-    //add it to the current token.
-    while((is_int(line[line_index + int_count]) == 1) && int_count <= TSIZE){
-        token_ptr[int_count] = line[line_index + int_count];
-        int_count++;
+/**
+ * @brief Converts an INT_LITERAL token to an int the same way atoi
+ * would, saturating at LONG_MAX before narrowing
+ *
+ * @param token the int literal token
+ */
+int int_value(token_t *token) {
+    long value = 0;
+    int i = 0;
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && LONG_MAX > 0x7fffffffL
+    //eight digits at a time while they cannot reach LONG_MAX
+    while (token->length - i >= 8 && value < 10000000000L) {
+        uint64_t digits;
+
+        memcpy(&digits, token->lexeme + i, 8);
+        digits -= 0x3030303030303030ULL;
+        digits = (digits * 10 + (digits >> 8)) & 0x00ff00ff00ff00ffULL;
+        digits = (digits * 100 + (digits >> 16)) & 0x0000ffff0000ffffULL;
+        digits = (digits * 10000 + (digits >> 32)) & 0xffffffffULL;
+        value = value * 100000000 + (long) digits;
+        i += 8;
     }
-    //Increment line_index by however long the int token is.
-    line_index += int_count;
+#endif
+    for (; i < token->length; i++) {
+        int digit = token->lexeme[i] - '0';
 
-    token_ptr[int_count + 1] = '\0';
+        if (value > (LONG_MAX - digit) / 10) {
+            value = LONG_MAX;
+            break;
+        }
+        value = value * 10 + digit;
+    }
+    return (int) value;
 }
 
 /**
  * This function handles lexical errors. It checks if the token
  * is a valid lexeme. If not, it will check if any proceeding characters are also invalid lexemes.
+ * The string lives in the arena of the context until the next line starts.
+ * @param ctx the line being read
  * @param token the current token
  * @return error the invalid lexemes or "OK".
  */
-char * get_lex_error(char * token, int* error_indicator) {
-    char * error = malloc(OPSIZE * sizeof(char)); //array to store lexemes
+char * get_lex_error(context_t * ctx, token_t * token, int* error_indicator) {
+    char * error = arena_alloc(ctx->arena, OPSIZE); //array to store lexemes
 
     //Check if the current token is invalid
-    if (strcmp(curr_cat, "NOT_A_TOKEN") == 0) {
-        error[0] = token[0];
-        get_token(token);
-
-        //Check if proceeding lexemes are valid.
-        construct_lex_error(token, error, error_indicator);
+    if (token->kind == NOT_A_TOKEN) {
+        error[0] = token->lexeme[0];
+        error[1] = '\0';
+
+        //Check if proceeding lexemes are valid, unless the line ended.
+        if (next_token(ctx, token)) {
+            error = construct_lex_error(ctx, token, error, error_indicator);
+        } else {
+            *error_indicator = 0;
+        }
     }
         //If the lexeme is valid, set error to "OK"
     else {
@@ -297,25 +389,54 @@ char * get_lex_error(char * token, int* error_indicator) {
 /**
  * This function is passed an invalid lexeme and checks proceeding
  * lexemes to see if they are also invalid.
+ * @param ctx the line being read
  * @param token the current token
- * @param error the string that will hold the invalid lexemes.
+ * @param error the string that will hold the invalid lexemes, OPSIZE bytes
+ *              from the arena of the context holding the first one
  * @param error_indicator the int that represents a lexical error
+ * @return error, moved if it had to grow past OPSIZE
  */
-void construct_lex_error(char * token, char * error, int* error_indicator) {
+char * construct_lex_error(context_t * ctx, token_t * token, char * error, int* error_indicator) {
     //Create an int to hold the length of the error array.
     int error_length = 1;
+    int error_capacity = OPSIZE;
     //While the next token is invalid
-    while (strcmp(curr_cat, "NOT_A_TOKEN") == 0) {
+    while (token->kind == NOT_A_TOKEN) {
+        //Make room for it and the '\0'
+        if (error_length + 1 == error_capacity) {
+            error = arena_grow(ctx->arena, error, error_capacity, 2 * error_capacity);
+            error_capacity *= 2;
+        }
         //Add it to error
-        error[error_length] = token[0];
+        error[error_length] = token->lexeme[0];
         //Increment the length of error
         error_length++;
-        //And get the next token
-        get_token(token);
+        //And get the next token, unless the line ended
+        if (!next_token(ctx, token)) {
+            break;
+        }
     }
+    error[error_length] = '\0';
 
     *error_indicator = 0;
+    return error;
 }
 
+/**
+ * @brief Returns the name of a token category, for diagnostics only
+ *
+ * @param kind the category of a token
+ */
+const char * category_name(enum token_kind kind) {
+    return category_names[kind];
+}
 
-
+/**
+ * @brief Writes a token and the name of its category to a file
+ *
+ * @param output the file to write to
+ * @param token the token to be written
+ */
+void print_to_file(FILE *output, token_t *token) {
+    fprintf(output, "%.*s\t%s\n", token->length, token->lexeme, category_name(token->kind));
+}
@@ -5,42 +5,53 @@
  */
 
 /* Constants */
-#define LINE 100
-#define TSIZE 20
 #define OPSIZE 35
 #define TRUE 1
 #define FALSE 0
 #define LOOP 1
 
-/* operators */
-#define ADD_OP +
-#define SUB_OP -
-#define MULTI_OP *
-#define DIV_OP /
-#define LEFT_PAREN (
-#define RIGHT_PAREN )
-#define EXPON_OP ^
-#define ASSIGN_OP =
-#define LESS_THEN_OP <
-#define LES_THEN_OR_EQUAL_OP <=
-#define GREATER_THEN_OP >
-#define GREATER_THEN_OR_EQUAL_OP >=
-#define EQUALS_OP ==
-#define NOP_OP !
-#define NOT_EQUALS_OP !=
-#define SEMI_COLON
+/* token categories */
+enum token_kind {
+    ADD_OP,
+    SUB_OP,
+    MULT_OP,
+    DIV_OP,
+    LEFT_PAREN,
+    RIGHT_PAREN,
+    EXPON_OP,
+    LESS_THEN_OP,
+    LESS_THEN_OR_EQUAL_OP,
+    GREATER_THEN_OP,
+    GREATER_THEN_OR_EQUAL_OP,
+    EQUALS_OP,
+    NOT_EQUALS_OP,
+    SEMI_COLON,
+    INT_LITERAL,
+    IDENTIFIER,
+    ASSIGN_OP,
+    NOT_A_TOKEN,
+    TOKEN_KINDS /* number of categories */
+};
+
+/* a lexeme together with the category it was classified as */
+typedef struct token {
+    enum token_kind kind;
+    const char *lexeme; /* points into the line, not null terminated */
+    int length;
+} token_t;
 
 /* libraries*/
 #include <ctype.h>
 #include <stdio.h>
 
 /*function headers*/
-int get_token(char *token);
-void classify_token(char *token);
-void single_token(char *token, char token_char);
-void two_token(char token_ptr[TSIZE], char token_char1,char token_char2);
-int is_int(char pos_int);
-void make_int(char token_ptr[TSIZE]);
-void print_to_file(FILE *output, char *token, char *category);
-void construct_lex_error(char * token, char * error, int* error_indicator);
-char * get_lex_error(char * token, int* error_indicator);
+struct context;
+int get_token(struct context *ctx, token_t *token);
+int at_line_end(struct context *ctx);
+int assignment_ahead(struct context *ctx);
+int has_identifier(const char *line);
+int int_value(token_t *token);
+const char * category_name(enum token_kind kind);
+void print_to_file(FILE *output, token_t *token);
+char * construct_lex_error(struct context * ctx, token_t * token, char * error, int* error_indicator);
+char * get_lex_error(struct context * ctx, token_t * token, int* error_indicator);
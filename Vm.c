@@ -0,0 +1,236 @@
+/*
+ * vm.c - compiles a tree from ast.c into flat bytecode for a stack
+ * machine and runs it.
+ * Every operator of the grammar is one instruction, so evaluating a
+ * number costs one push instead of a call per non-terminal, and a
+ * variable one load from the slot its name was resolved to. With GCC or
+ * Clang the dispatch loop jumps straight from one instruction to the next
+ * through a table of label addresses, otherwise it falls back to a switch.
+ * Date:   October 17, 2026
+ */
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <math.h>
+
+#include "Tokenizer.h"
+
+#include "Output.h"
+
+#include "Context.h"
+
+#include "Ast.h"
+
+#include "Big.h"
+
+#include "Vm.h"
+
+#include "Symbols.h"
+
+#if defined(__GNUC__) && !defined(NO_COMPUTED_GOTO)
+#define COMPUTED_GOTO
+#endif
+
+
+/* Instruction for each kind of operator node */
+static const enum opcode node_codes[] = {
+   [ADD_NODE] = ADD_CODE,
+   [SUB_NODE] = SUB_CODE,
+   [MULT_NODE] = MULT_CODE,
+   [DIV_NODE] = DIV_CODE,
+   [EXPON_NODE] = EXPON_CODE,
+   [LESS_THEN_NODE] = LESS_THEN_CODE,
+   [LESS_THEN_OR_EQUAL_NODE] = LESS_THEN_OR_EQUAL_CODE,
+   [GREATER_THEN_NODE] = GREATER_THEN_CODE,
+   [GREATER_THEN_OR_EQUAL_NODE] = GREATER_THEN_OR_EQUAL_CODE,
+   [EQUALS_NODE] = EQUALS_CODE,
+   [NOT_EQUALS_NODE] = NOT_EQUALS_CODE,
+   [SQUARE_NODE] = SQUARE_CODE,
+   [SHIFT_LEFT_NODE] = SHIFT_LEFT_CODE,
+   [SHIFT_RIGHT_NODE] = SHIFT_RIGHT_CODE
+};
+
+
+/**
+ * Sets up an empty program
+ * @param program the program
+ */
+void program_init(program_t * program) {
+   program->code = NULL;
+   program->count = 0;
+   program->capacity = 0;
+   program->depth = 0;
+   program->max_depth = 0;
+   program->stack = NULL;
+   program->stack_capacity = 0;
+   program->variables = NULL;
+   program->status = ARITH_OK;
+}
+
+/**
+ * Releases the memory of a program
+ * @param program the program
+ */
+void program_free(program_t * program) {
+   free(program->code);
+   free(program->stack);
+   program_init(program);
+}
+
+/**
+ * Appends one word of bytecode, growing the program when full
+ * @param program the program
+ * @param word the opcode or operand
+ */
+static void emit(program_t * program, int word) {
+   if (program->count == program->capacity) {
+      int capacity = program->capacity ? program->capacity * 2 : 64;
+      int *code = realloc(program->code, capacity * sizeof(int));
+
+      if (code == NULL)
+         out_of_memory("ERROR: out of memory for bytecode");
+      program->code = code;
+      program->capacity = capacity;
+   }
+   program->code[program->count++] = word;
+}
+
+/**
+ * Replaces the program with the bytecode for a tree
+ * @param program the program
+ * @param ast the arena holding the tree
+ * @param root the root of the tree
+ */
+void compile(program_t * program, ast_t * ast, int root) {
+   int count = ast_order(ast, root);
+   int i;
+
+   program->count = 0;
+   program->depth = 0;
+   program->max_depth = 0;
+   program->variables = ast->symbols != NULL ? ast->symbols->values : NULL;
+
+   //operands come before their operator in the order, as on the stack
+   for (i = 0; i < count; i++) {
+      node_t *node = &ast->nodes[ast->order[i]];
+
+      if (node->kind == NUM_NODE || node->kind == VARIABLE_NODE) {
+         emit(program, node->kind == NUM_NODE ? PUSH_CODE : LOAD_CODE);
+         emit(program, node->value);
+         if (++program->depth > program->max_depth)
+            program->max_depth = program->depth;
+      } else {
+         emit(program, node_codes[node->kind]);
+         //a unary operator replaces the value on top of the stack
+         if (node->right != NO_NODE)
+            program->depth--;
+      }
+   }
+   emit(program, HALT_CODE);
+
+   if (program->max_depth > program->stack_capacity) {
+      free(program->stack);
+      program->stack_capacity = 0;
+      program->stack = malloc(program->max_depth * sizeof(int));
+      if (program->stack == NULL)
+         out_of_memory("ERROR: out of memory for the value stack");
+      program->stack_capacity = program->max_depth;
+   }
+}
+
+/**
+ * Runs a compiled program with the same arithmetic as parser.c, leaving
+ * ARITH_OK in its status, or the first division that had no result
+ * @param program the program
+ * @return the value of the statement, of no use unless the status is ARITH_OK
+ */
+int vm_run(program_t * program) {
+   const int *pc = program->code;
+   int *sp = program->stack; // next free slot of the value stack
+   const int *variables = program->variables;
+
+   program->status = ARITH_OK;
+
+#ifdef COMPUTED_GOTO
+   static void *labels[] = {
+      [PUSH_CODE] = &&push,
+      [LOAD_CODE] = &&load,
+      [ADD_CODE] = &&add,
+      [SUB_CODE] = &&sub,
+      [MULT_CODE] = &&mult,
+      [DIV_CODE] = &&div,
+      [EXPON_CODE] = &&expon,
+      [LESS_THEN_CODE] = &&less_then,
+      [LESS_THEN_OR_EQUAL_CODE] = &&less_then_or_equal,
+      [GREATER_THEN_CODE] = &&greater_then,
+      [GREATER_THEN_OR_EQUAL_CODE] = &&greater_then_or_equal,
+      [EQUALS_CODE] = &&equals,
+      [NOT_EQUALS_CODE] = &&not_equals,
+      [SQUARE_CODE] = &&square,
+      [SHIFT_LEFT_CODE] = &&shift_left,
+      [SHIFT_RIGHT_CODE] = &&shift_right,
+      [HALT_CODE] = &&halt
+   };
+   #define DISPATCH() goto *labels[*pc++]
+   #define CASE(code, name) name:
+#else
+   #define DISPATCH() goto dispatch
+   #define CASE(code, name) case code:
+#endif
+
+   // binary operators pop the right operand and replace the left one
+   #define BINARY(expression) sp--; sp[-1] = (expression); DISPATCH()
+
+#ifdef COMPUTED_GOTO
+   DISPATCH();
+#else
+dispatch:
+   switch (*pc++) {
+#endif
+   CASE(PUSH_CODE, push)
+      *sp++ = *pc++;
+      DISPATCH();
+   CASE(LOAD_CODE, load)
+      *sp++ = variables[*pc++];
+      DISPATCH();
+   CASE(ADD_CODE, add)
+      BINARY(sp[-1] + sp[0]);
+   CASE(SUB_CODE, sub)
+      BINARY(sp[-1] - sp[0]);
+   CASE(MULT_CODE, mult)
+      BINARY(sp[-1] * sp[0]);
+   CASE(DIV_CODE, div)
+      BINARY(int_divide(sp[-1], sp[0], &program->status));
+   CASE(EXPON_CODE, expon)
+      BINARY((int) pow(sp[-1], sp[0]));
+   CASE(LESS_THEN_CODE, less_then)
+      BINARY(sp[-1] < sp[0]);
+   CASE(LESS_THEN_OR_EQUAL_CODE, less_then_or_equal)
+      BINARY(sp[-1] <= sp[0]);
+   CASE(GREATER_THEN_CODE, greater_then)
+      BINARY(sp[-1] > sp[0]);
+   CASE(GREATER_THEN_OR_EQUAL_CODE, greater_then_or_equal)
+      BINARY(sp[-1] >= sp[0]);
+   CASE(EQUALS_CODE, equals)
+      BINARY(sp[-1] == sp[0]);
+   CASE(NOT_EQUALS_CODE, not_equals)
+      BINARY(sp[-1] != sp[0]);
+   CASE(SQUARE_CODE, square)
+      sp[-1] = (int) ((double) sp[-1] * sp[-1]);
+      DISPATCH();
+   CASE(SHIFT_LEFT_CODE, shift_left)
+      BINARY((int) ((unsigned int) sp[-1] << sp[0]));
+   CASE(SHIFT_RIGHT_CODE, shift_right)
+      BINARY((sp[-1] + ((sp[-1] >> 31) & ((1 << sp[0]) - 1))) >> sp[0]);
+   CASE(HALT_CODE, halt)
+      return sp[-1];
+#ifndef COMPUTED_GOTO
+   }
+   return sp[-1];
+#endif
+
+   #undef BINARY
+   #undef CASE
+   #undef DISPATCH
+}
@@ -0,0 +1,49 @@
+#ifndef VM_H
+   #define VM_H
+
+/* instructions of the stack machine, PUSH_CODE is followed by its value
+   and LOAD_CODE by the slot of a variable */
+enum opcode {
+   PUSH_CODE,
+   LOAD_CODE,
+   ADD_CODE,
+   SUB_CODE,
+   MULT_CODE,
+   DIV_CODE,
+   EXPON_CODE,
+   LESS_THEN_CODE,
+   LESS_THEN_OR_EQUAL_CODE,
+   GREATER_THEN_CODE,
+   GREATER_THEN_OR_EQUAL_CODE,
+   EQUALS_CODE,
+   NOT_EQUALS_CODE,
+   SQUARE_CODE,
+   SHIFT_LEFT_CODE,
+   SHIFT_RIGHT_CODE,
+   HALT_CODE
+};
+
+/* flat bytecode for one statement and the value stack it needs */
+typedef struct program {
+   int *code;
+   int count;
+   int capacity;
+   int depth;     // height of the value stack while compiling
+   int max_depth; // highest the value stack gets when run
+   int *stack;
+   int stack_capacity;
+   const int *variables; // values of the variables LOAD_CODE reads
+   int status;           // ARITH_OK, or the first arithmetic error of the last vm_run
+} program_t;
+
+/*
+ * Purpose: Function Prototypes for vm.c
+ * Date:    October 17, 2026
+ */
+void program_init(program_t *);
+void program_free(program_t *);
+void compile(program_t *, ast_t *, int);
+int vm_run(program_t *);
+
+
+#endif
@@ -0,0 +1,493 @@
+/**
+ * watch.c - runs the input file again each time it changes, for -w,
+ * lexing and evaluating only the lines that changed and writing only the
+ * part of the output file that changed.
+ *
+ * The text of the input and what each line of it wrote are kept from one
+ * run to the next. When the file changes, the bytes it starts and ends
+ * with that did not change are found by comparing it with the old text,
+ * and every line that lies wholly inside them keeps the output it had.
+ * Only the lines in between are run. The output file is compared with
+ * the new output the same way: if its size did not change only the bytes
+ * that differ are written over, otherwise everything from the first byte
+ * that differs on is written and the file is cut to its new length.
+ *
+ * A line that used a variable may read what a line above it assigned.
+ * Before the changed lines run, the variables are rebuilt by running the
+ * lines above them that used one, with their output thrown away, and if
+ * a changed line used one, every later line that did runs again too.
+ * Inputs without variables never pay for this.
+ *
+ * Finding the change costs a read and a compare of the whole file, which
+ * go at the speed of memory; the records and output of the lines after
+ * the change are moved, not run.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "Library.h"
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Ast.h"
+#include "Big.h"
+#include "Arith.h"
+#include "Vm.h"
+#include "Iterative.h"
+#include "Cache.h"
+#include "Arena.h"
+#include "Stats.h"
+#include "Input.h"
+#include "Symbols.h"
+#include "Interpreter.h"
+
+#define WATCH_INTERVAL 20000000 // nanoseconds between looks at the input
+
+/* one line of the input and what it wrote */
+typedef struct watch_line {
+    size_t start;         // where it starts in the text
+    size_t length;        // bytes in it, with its '\n'
+    size_t output;        // where its output starts in the outputs
+    size_t output_length;
+    int stateful;         // 1 if it used a variable
+} watch_line_t;
+
+/* the input as it was last run */
+typedef struct watch {
+    char *text;           // followed by a '\0'
+    size_t size;
+    watch_line_t *lines;
+    long count;
+    long capacity;
+    output_t outputs;     // the output of every line, in order, as in the output file
+    output_t changed;     // the output of the lines that changed
+} watch_t;
+
+static volatile sig_atomic_t stopping; // set by SIGINT and SIGTERM
+
+
+/**
+ * Stops watching.
+ *
+ * @param signal the signal
+ */
+static void stop(int signal) {
+    (void) signal;
+    stopping = 1;
+}
+
+/**
+ * Reads a whole file into memory.
+ *
+ * @param path the file
+ * @param size set to its number of bytes
+ * @return the bytes followed by a '\0', NULL if it could not be read
+ */
+static char *read_all(const char *path, size_t *size) {
+    struct stat info;
+    char *text;
+    size_t done = 0;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &info) != 0 || (text = malloc(info.st_size + 1)) == NULL) {
+        close(fd);
+        return NULL;
+    }
+    while (done < (size_t) info.st_size) {
+        ssize_t got = read(fd, text + done, info.st_size - done);
+
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            break;
+        }
+        done += got;
+    }
+    close(fd);
+    text[done] = '\0';
+    *size = done;
+    return text;
+}
+
+/**
+ * Writes bytes at an offset of a file, carrying on after partial writes.
+ *
+ * @param fd the file
+ * @param bytes the bytes
+ * @param length the number of bytes
+ * @param offset where they go
+ */
+static void write_at(int fd, const char *bytes, size_t length, size_t offset) {
+    while (length > 0) {
+        ssize_t written = pwrite(fd, bytes, length, offset);
+
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            fprintf(stderr, "ERROR: could not write the output file\n");
+            exit(1);
+        }
+        bytes += written;
+        offset += written;
+        length -= written;
+    }
+}
+
+/**
+ * @param a some bytes
+ * @param b some more
+ * @param length the most bytes to compare
+ * @return how many bytes both start with
+ */
+static size_t same_start(const char *a, const char *b, size_t length) {
+    size_t done = 0;
+
+    //memcmp finds a whole block that matches faster than a loop over its bytes
+    while (length - done >= 4096 && memcmp(a + done, b + done, 4096) == 0) {
+        done += 4096;
+    }
+    while (done < length && a[done] == b[done]) {
+        done++;
+    }
+    return done;
+}
+
+/**
+ * @param a the end of some bytes
+ * @param b the end of some more
+ * @param length the most bytes to compare
+ * @return how many bytes both end with
+ */
+static size_t same_end(const char *a, const char *b, size_t length) {
+    size_t done = 0;
+
+    while (length - done >= 4096 && memcmp(a - done - 4096, b - done - 4096, 4096) == 0) {
+        done += 4096;
+    }
+    while (done < length && a[-1 - (long) done] == b[-1 - (long) done]) {
+        done++;
+    }
+    return done;
+}
+
+/**
+ * Makes room for more lines.
+ *
+ * @param watch the watch
+ * @param count the number of lines there has to be room for
+ */
+static void reserve(watch_t *watch, long count) {
+    if (count <= watch->capacity) {
+        return;
+    }
+    watch->capacity = watch->capacity ? watch->capacity : 4096;
+    while (watch->capacity < count) {
+        watch->capacity *= 2;
+    }
+    watch->lines = realloc(watch->lines, watch->capacity * sizeof(watch_line_t));
+    if (watch->lines == NULL) {
+        fprintf(stderr, "ERROR: out of memory for the lines of the input\n");
+        exit(1);
+    }
+}
+
+/**
+ * @param watch the watch
+ * @param offset a byte of the old text
+ * @return the first line that is not wholly before the byte
+ */
+static long line_at(const watch_t *watch, size_t offset) {
+    long low = 0;
+    long high = watch->count;
+
+    while (low < high) {
+        long middle = (low + high) / 2;
+        const watch_line_t *line = &watch->lines[middle];
+
+        if (line->start + line->length <= offset && watch->text[line->start + line->length - 1] == '\n') {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * Runs a line, adding what it wrote to an output.
+ *
+ * @param worker the worker
+ * @param out the output
+ * @param text the line
+ * @param line its record, whose output is filled in
+ */
+static void run_into(worker_t *worker, output_t *out, const char *text, watch_line_t *line) {
+    line->output = out->size;
+    worker->ctx.out = out;
+    run_line(worker, text, line->length);
+    line->output_length = out->size - line->output;
+    line->stateful = worker->ctx.stateful;
+}
+
+/**
+ * Replaces part of the outputs with the output of the changed lines,
+ * moving what follows it.
+ *
+ * @param outputs the outputs, in memory
+ * @param from where the part starts
+ * @param to where it ends
+ * @param changed what goes in its place
+ */
+static void replace_outputs(output_t *outputs, size_t from, size_t to, const output_t *changed) {
+    size_t size = outputs->size - (to - from) + changed->size;
+
+    if (size > outputs->capacity) {
+        while (size > outputs->capacity) {
+            outputs->capacity *= 2;
+        }
+        outputs->data = realloc(outputs->data, outputs->capacity);
+        if (outputs->data == NULL) {
+            fprintf(stderr, "ERROR: out of memory for the output\n");
+            exit(1);
+        }
+    }
+    memmove(outputs->data + from + changed->size, outputs->data + to, outputs->size - to);
+    memcpy(outputs->data + from, changed->data, changed->size);
+    outputs->size = size;
+}
+
+/**
+ * Brings the outputs up to date with a new text of the input and writes
+ * what changed to the output file.
+ *
+ * @param watch the input as it was last run, then as it is now
+ * @param worker the worker that runs the lines
+ * @param fd the output file
+ * @param text the new text, which the watch takes over
+ * @param size its number of bytes
+ */
+static void update(watch_t *watch, worker_t *worker, int fd, char *text, size_t size) {
+    output_t *outputs = &watch->outputs;
+    output_t *changed = &watch->changed;
+    size_t common = size < watch->size ? size : watch->size;
+    size_t prefix;
+    size_t suffix;
+    long long shift = (long long) size - (long long) watch->size;
+    long long moved;    // how far the output of the lines after the change moves
+    long first, last, added = 0, ran = 0;
+    long i;
+    int variables = 0;  // 1 if a line that was run or removed used a variable
+    int rerun = 0;      // 1 if a line after the change has to run again
+    watch_line_t *records;
+    output_t discard;
+    size_t from, to, old_from, old_to, old_size;
+    struct timespec started, now;
+
+    clock_gettime(CLOCK_MONOTONIC, &started);
+    prefix = same_start(text, watch->text, common);
+    suffix = same_end(text + size, watch->text + watch->size, common - prefix);
+
+    //lines wholly in the prefix, and from last on wholly in the suffix, keep their output
+    first = line_at(watch, prefix);
+    for (last = line_at(watch, watch->size - suffix); last < watch->count
+         && watch->lines[last].start <= watch->size - suffix; last++) {
+    }
+    for (i = first; i < last; i++) {
+        variables |= watch->lines[i].stateful;
+    }
+
+    //the variables as the lines above the change left them
+    symbols_reset(&worker->symbols);
+    output_memory(&discard);
+    for (i = 0; i < first; i++) {
+        if (watch->lines[i].stateful) {
+            watch_line_t copy = watch->lines[i];
+
+            run_into(worker, &discard, watch->text + copy.start, &copy);
+            discard.size = 0;
+        }
+    }
+    free(discard.data);
+
+    //the changed lines, with records after the old ones and outputs of their own
+    changed->size = 0;
+    from = first < watch->count ? watch->lines[first].start : watch->size;
+    to = last < watch->count ? watch->lines[last].start + shift : size;
+    while (from < to) {
+        const char *newline = memchr(text + from, '\n', to - from);
+        watch_line_t *line;
+
+        reserve(watch, watch->count + added + 1);
+        line = &watch->lines[watch->count + added++];
+        line->start = from;
+        line->length = newline != NULL ? (size_t) (newline - text) + 1 - from : to - from;
+        run_into(worker, changed, text + from, line);
+        variables |= line->stateful;
+        ran++;
+        from += line->length;
+    }
+
+    old_from = first < watch->count ? watch->lines[first].output : outputs->size;
+    old_to = last < watch->count ? watch->lines[last].output : outputs->size;
+    old_size = outputs->size;
+    moved = (long long) changed->size - (long long) (old_to - old_from);
+    for (i = last; variables && i < watch->count && !rerun; i++) {
+        rerun = watch->lines[i].stateful;
+    }
+
+    if (!rerun) {
+        //the output of the changed lines is all that differs
+        common = changed->size < old_to - old_from ? changed->size : old_to - old_from;
+        from = old_from + same_start(changed->data, outputs->data + old_from, common);
+        to = old_from + changed->size;
+        if (moved == 0) {
+            to -= same_end(changed->data + changed->size, outputs->data + old_to, to - from);
+        }
+        replace_outputs(outputs, old_from, old_to, changed);
+        if (moved != 0) {
+            to = outputs->size;
+        }
+        for (i = last; i < watch->count; i++) {
+            watch->lines[i].start += shift;
+            watch->lines[i].output += moved;
+        }
+    } else {
+        //the lines after the change that used a variable may write something else
+        output_t next;
+
+        output_memory(&next);
+        output_write(&next, outputs->data, old_from);
+        output_write(&next, changed->data, changed->size);
+        for (i = last; i < watch->count; i++) {
+            watch_line_t *line = &watch->lines[i];
+
+            line->start += shift;
+            if (line->stateful) {
+                run_into(worker, &next, text + line->start, line);
+                ran++;
+            } else {
+                output_write(&next, outputs->data + line->output, line->output_length);
+                line->output = next.size - line->output_length;
+            }
+        }
+        common = next.size < old_size ? next.size : old_size;
+        from = old_from + same_start(next.data + old_from, outputs->data + old_from, common - old_from);
+        to = next.size;
+        if (next.size == old_size) {
+            to -= same_end(next.data + to, outputs->data + to, to - from);
+        }
+        free(outputs->data);
+        *outputs = next;
+    }
+
+    //put the new records in place of the changed ones
+    records = malloc((added ? added : 1) * sizeof(watch_line_t));
+    if (records == NULL) {
+        fprintf(stderr, "ERROR: out of memory for the lines of the input\n");
+        exit(1);
+    }
+    memcpy(records, &watch->lines[watch->count], added * sizeof(watch_line_t));
+    for (i = 0; i < added; i++) {
+        records[i].output += old_from;
+    }
+    reserve(watch, first + added + (watch->count - last));
+    memmove(&watch->lines[first + added], &watch->lines[last],
+            (watch->count - last) * sizeof(watch_line_t));
+    memcpy(&watch->lines[first], records, added * sizeof(watch_line_t));
+    watch->count = first + added + (watch->count - last);
+    free(records);
+
+    write_at(fd, outputs->data + from, to - from, from);
+    if (outputs->size != old_size && ftruncate(fd, outputs->size) != 0) {
+        fprintf(stderr, "ERROR: could not write the output file\n");
+        exit(1);
+    }
+    free(watch->text);
+    watch->text = text;
+    watch->size = size;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    fprintf(stderr, "Ran %ld of %ld lines, wrote %zu bytes of output in %.3f ms\n", ran, watch->count,
+            to - from, (now.tv_sec - started.tv_sec) * 1e3 + (now.tv_nsec - started.tv_nsec) / 1e6);
+}
+
+/**
+ * @param a what stat said about a file
+ * @param b what it said another time
+ * @return 1 if the file may have changed in between
+ */
+static int differ(const struct stat *a, const struct stat *b) {
+    return a->st_size != b->st_size || a->st_ino != b->st_ino
+           || a->st_mtim.tv_sec != b->st_mtim.tv_sec || a->st_mtim.tv_nsec != b->st_mtim.tv_nsec;
+}
+
+/**
+ * Runs the input, then runs it again each time it changes, until SIGINT
+ * or SIGTERM. The file is looked at every WATCH_INTERVAL nanoseconds and
+ * read again when its size, time of change or inode differ, so an editor
+ * that writes a new file and renames it over the old one is seen too. It
+ * is only read once it looks the same twice in a row, so a file that is
+ * cut short and then written is not run while it is half written.
+ *
+ * @param worker the worker, which echoes the lines
+ * @param out the output file, which is written with pwrite, never buffered
+ * @param path the input file
+ */
+void run_watch(worker_t * worker, output_t * out, const char * path) {
+    struct timespec interval = {0, WATCH_INTERVAL};
+    struct sigaction action;
+    struct stat seen, settling, info;
+    watch_t watch;
+    output_t *results = worker->ctx.out;
+    char *text;
+    size_t size;
+
+    memset(&watch, 0, sizeof(watch));
+    watch.text = calloc(1, 1);
+    output_memory(&watch.outputs);
+    output_memory(&watch.changed);
+    if (watch.text == NULL) {
+        fprintf(stderr, "ERROR: out of memory for the input\n");
+        exit(1);
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    memset(&seen, 0, sizeof(seen));
+    memset(&settling, 0, sizeof(settling));
+    while (!stopping) {
+        if (stat(path, &info) == 0 && differ(&info, &seen)) {
+            if (!differ(&info, &settling) && (text = read_all(path, &size)) != NULL) {
+                seen = info;
+                update(&watch, worker, out->fd, text, size);
+            }
+            settling = info;
+        }
+        nanosleep(&interval, NULL);
+    }
+
+    worker->ctx.out = results;
+    free(watch.outputs.data);
+    free(watch.changed.data);
+    free(watch.lines);
+    free(watch.text);
+}
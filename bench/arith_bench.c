@@ -0,0 +1,220 @@
+/**
+ * arith_bench.c - Cost of the 64-bit checked and big arithmetic modes
+ * against the int tree walker, and how big numbers scale with their size.
+ *
+ * Each statement is parsed once, only evaluation is timed. The big number
+ * part times multiplication, ^ and printing in decimal at growing sizes.
+ * Build it a second time with -DKARATSUBA_MIN=1000000 to see the same
+ * multiplications done the schoolbook way.
+ *
+ * Build: gcc -O2 -I.. -o arith_bench arith_bench.c ../Tokenizer.c ../Parser.c ../Symbols.c ../Ast.c ../Big.c ../Arith.c ../Arena.c ../Scan.c ../Output.c -lm
+ * Usage: arith_bench [iterations]
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Parser.h"
+#include "Ast.h"
+#include "Big.h"
+#include "Arith.h"
+
+static output_t diagnostics; // where syntax errors would be reported
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Builds a flat statement of width terms that stays small: 3 * 4 + 5 - 6 ...
+ * @return the statement, to be freed by the caller
+ */
+static char *wide(int width) {
+    static const char *ops[] = {" + ", " * ", " - ", " >= ", " / ", " != "};
+    char *text = malloc(width * 12 + 8);
+    char *pos = text;
+    int i;
+
+    pos += sprintf(pos, "%d", 17);
+    for (i = 1; i < width; i++) {
+        pos += sprintf(pos, "%s%d", ops[i % 6], 1 + i % 97);
+    }
+    strcpy(pos, ";");
+    return text;
+}
+
+/**
+ * Times the three modes on one statement and prints the results
+ * @param name the name of the workload
+ * @param text the statement
+ * @param iterations how many times each mode evaluates it
+ */
+static void run(const char *name, const char *text, int iterations) {
+    context_t ctx;
+    token_t token;
+    ast_t ast;
+    registers_t registers;
+    long long wide_value = 0;
+    int int_value = 0;
+    int status = ARITH_OK;
+    int root;
+    int i;
+    double start, int_time, checked_time, big_time;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = &diagnostics;
+    ctx.line = text;
+    ast_init(&ast);
+    registers_init(&registers);
+    get_token(&ctx, &token);
+    root = parse_bexpr(&ctx, &ast, &token);
+    if (root == NO_NODE) {
+        fprintf(stderr, "%s does not parse\n", name);
+        exit(1);
+    }
+
+    start = now();
+    for (i = 0; i < iterations; i++) {
+        int_value += ast_eval(&ast, root);
+    }
+    int_time = now() - start;
+
+    start = now();
+    for (i = 0; i < iterations; i++) {
+        status |= ast_eval_checked(&ast, root, &wide_value);
+    }
+    checked_time = now() - start;
+
+    start = now();
+    for (i = 0; i < iterations; i++) {
+        status |= ast_eval_big(&registers, &ast, root);
+    }
+    big_time = now() - start;
+
+    printf("%s (%d nodes)%s\n", name, ast.count, status == ARITH_OK ? "" : ", had errors");
+    printf("  int:     %10.0f ns/statement\n", int_time / iterations * 1e9);
+    printf("  checked: %10.0f ns/statement (%.2fx int)\n",
+           checked_time / iterations * 1e9, checked_time / int_time);
+    printf("  big:     %10.0f ns/statement (%.2fx int)\n",
+           big_time / iterations * 1e9, big_time / int_time);
+
+    if (int_value == 42 && wide_value == 42) {
+        printf("\n"); // keeps the loops from being optimized away
+    }
+    registers_free(&registers);
+    ast_free(&ast);
+}
+
+/**
+ * Fills a number with the given count of random decimal digits
+ * @param big the number
+ * @param length the number of digits
+ */
+static void random_digits(big_t *big, int length) {
+    char *digits = malloc(length);
+    int i;
+
+    for (i = 0; i < length; i++) {
+        digits[i] = '0' + rand() % 10;
+    }
+    digits[0] = '1' + rand() % 9;
+    big_digits(big, digits, length);
+    free(digits);
+}
+
+/**
+ * Times multiplying two numbers of the same size, raising 3 to a power
+ * with about as many bits, and printing the power in decimal
+ */
+static void scaling(void) {
+    static const int sizes[] = {8, 32, 128, 512, 2048, 8192};
+    output_t sink;
+    big_t a, b, product, base, exponent, power;
+    int s;
+
+    output_memory(&sink);
+    big_init(&a);
+    big_init(&b);
+    big_init(&product);
+    big_init(&base);
+    big_init(&exponent);
+    big_init(&power);
+    big_set(&base, 3);
+
+    printf("big numbers, KARATSUBA_MIN %d\n", KARATSUBA_MIN);
+    printf("  %6s %14s %14s %14s\n", "limbs", "a * b", "3 ^ n", "decimal");
+    for (s = 0; s < (int) (sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int limbs = sizes[s];
+        int repeat = 1 + 200000 / limbs / limbs;
+        double start, mul_time, pow_time, print_time;
+        int i;
+
+        //about 9.63 decimal digits per limb
+        random_digits(&a, limbs * 963 / 100);
+        random_digits(&b, limbs * 963 / 100);
+
+        start = now();
+        for (i = 0; i < repeat * 10; i++) {
+            big_mul(&product, &a, &b);
+        }
+        mul_time = (now() - start) / (repeat * 10);
+
+        //log2(3) is about 1.585, so 3^n has about 1.585 n bits
+        big_set(&exponent, (long long) limbs * 32 * 1000 / 1585);
+        start = now();
+        for (i = 0; i < repeat; i++) {
+            big_pow(&power, &base, &exponent);
+        }
+        pow_time = (now() - start) / repeat;
+
+        start = now();
+        for (i = 0; i < repeat; i++) {
+            sink.size = 0;
+            output_big(&sink, &power);
+        }
+        print_time = (now() - start) / repeat;
+
+        printf("  %6d %11.1f us %11.1f us %11.1f us\n", limbs,
+               mul_time * 1e6, pow_time * 1e6, print_time * 1e6);
+    }
+
+    big_free(&power);
+    big_free(&exponent);
+    big_free(&base);
+    big_free(&product);
+    big_free(&b);
+    big_free(&a);
+    free(sink.data);
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+    char *text;
+
+    output_fd(&diagnostics, 2);
+
+    run("short, 3 terms", "12 * 34 + 5;", iterations);
+    run("powers, 2 ^ 40 and 7 ^ 20", "2 ^ 40 - 7 ^ 20 / 3;", iterations);
+    text = wide(1000);
+    run("wide, 1000 terms", text, iterations / 100);
+    free(text);
+    run("large literals", "123456789012345678901234567890 * 987654321098765432109876543210;",
+        iterations);
+
+    scaling();
+
+    output_flush(&diagnostics);
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * column_bench.c - The block evaluator of column.c against walking the
+ * tree of the same expression once per row with ast_eval_checked, which
+ * is what a line per row costs once it has been parsed.
+ *
+ * A few fixed expressions are timed both ways over four columns of
+ * values that seldom overflow, as real data does. Then the columns are
+ * filled again with values some of which are small, some near the ends
+ * of 64 bits and some zero, so every kind of error shows up, and random
+ * expressions are only checked: any row where the two ways disagree on
+ * the value or the error stops the program.
+ *
+ * Build: gcc -O2 -I.. -o column_bench column_bench.c ../Column.c ../Tokenizer.c ../Parser.c ../Symbols.c
+ *            ../Ast.c ../Big.c ../Arith.c ../Iterative.c ../Optimize.c ../Arena.c ../Scan.c ../Input.c
+ *            ../Output.c -lm
+ * Usage: column_bench [rows] [seed]
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Parser.h"
+#include "Ast.h"
+#include "Big.h"
+#include "Arith.h"
+#include "Input.h"
+#include "Symbols.h"
+#include "Column.h"
+
+#define COLUMNS 4
+#define RANDOM_EXPRESSIONS 2000
+
+static const char *names[COLUMNS] = {"a", "b", "c", "d"};
+static output_t diagnostics; // where syntax and name errors are reported
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @param extreme 1 for values that make every kind of error likely
+ * @return a random value: with extreme, mostly small, sometimes 0 and
+ *         sometimes huge, otherwise below a million either way
+ */
+static long long random_value(int extreme) {
+    if (!extreme) {
+        return rand() % 2000001 - 1000000;
+    }
+    switch (rand() % 8) {
+    case 0:
+        return 0;
+    case 1:
+        return LLONG_MAX - rand() % 4;
+    case 2:
+        return LLONG_MIN + rand() % 4;
+    case 3:
+        return ((long long) rand() << 31 | rand()) - (1ll << 60);
+    default:
+        return rand() % 2001 - 1000;
+    }
+}
+
+/**
+ * Appends a random expression of the grammar over the columns
+ * @param pos where to write it
+ * @param depth how many more levels of operators it may have
+ * @return the end of what was written
+ */
+static char *random_expression(char *pos, int depth) {
+    static const char *ops[] = {" + ", " - ", " * ", " / ", " ^ ", " < ", " <= ",
+                                " > ", " >= ", " == ", " != "};
+
+    if (depth == 0 || rand() % 3 == 0) {
+        if (rand() % 3 == 0) {
+            return pos + sprintf(pos, "%d", rand() % 10);
+        }
+        return pos + sprintf(pos, "%s", names[rand() % COLUMNS]);
+    }
+    *pos++ = '(';
+    pos = random_expression(pos, depth - 1);
+    pos += sprintf(pos, "%s", ops[rand() % 11]);
+    pos = random_expression(pos, depth - 1);
+    *pos++ = ')';
+    return pos;
+}
+
+/**
+ * Runs an expression over every row both ways, stopping at the first row
+ * where they differ
+ * @param text the statement
+ * @param table the columns
+ * @param symbols the names of the columns, their values set per row
+ * @param timed 1 to print how long each way took
+ */
+static void run(const char *text, const table_t *table, symbols_t *symbols, int timed) {
+    context_t ctx;
+    token_t token;
+    ast_t ast;
+    batch_t batch;
+    long long *values = malloc(table->rows * sizeof(long long));
+    unsigned char *status = malloc(table->rows);
+    long long value;
+    int error = ARITH_OK;
+    long errors = 0;
+    double start, batch_time, tree_time;
+    long row;
+    int root;
+    int i;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = &diagnostics;
+    ctx.line = text;
+    ctx.symbols = symbols;
+    ast_init(&ast);
+    batch_init(&batch);
+    get_token(&ctx, &token);
+    root = parse_bexpr(&ctx, &ast, &token);
+    if (root == NO_NODE || values == NULL || status == NULL) {
+        fprintf(stderr, "%s does not parse\n", text);
+        exit(1);
+    }
+    //so the blocks are not timed faulting in the pages of the results
+    memset(values, 0, table->rows * sizeof(long long));
+    memset(status, 0, table->rows);
+
+    start = now();
+    batch_compile(&batch, &ast, root);
+    for (row = 0; row < table->rows; row += BATCH_ROWS) {
+        int rows = table->rows - row < BATCH_ROWS ? table->rows - row : BATCH_ROWS;
+
+        batch_run(&batch, table, row, rows, values + row, status + row);
+    }
+    batch_time = now() - start;
+
+    start = now();
+    for (row = 0; row < table->rows; row++) {
+        for (i = 0; i < COLUMNS; i++) {
+            symbols->wide[i] = table->columns[i][row];
+        }
+        value = 0;
+        error = ast_eval_checked(&ast, root, &value);
+        if (error != status[row] || (error == ARITH_OK && value != values[row])) {
+            fprintf(stderr, "%s differs on row %ld (a=%lld b=%lld c=%lld d=%lld):\n"
+                    "  blocks: %lld, %s\n  tree:   %lld, %s\n", text, row,
+                    table->columns[0][row], table->columns[1][row], table->columns[2][row],
+                    table->columns[3][row], values[row], arith_message(status[row]),
+                    value, arith_message(error));
+            exit(1);
+        }
+        errors += error != ARITH_OK;
+    }
+    tree_time = now() - start;
+
+    if (timed) {
+        printf("%s (%d nodes, %ld rows with errors)\n", text, ast.count, errors);
+        printf("  blocks: %8.2f ns/row\n", batch_time / table->rows * 1e9);
+        printf("  tree:   %8.2f ns/row (%.2fx blocks)\n",
+               tree_time / table->rows * 1e9, tree_time / batch_time);
+    }
+    batch_free(&batch);
+    ast_free(&ast);
+    free(values);
+    free(status);
+}
+
+/**
+ * The main function for the benchmark
+ * @param argc the argument count
+ * @param argv the argument list
+ * @return 0 if every expression agreed
+ */
+int main(int argc, char *argv[]) {
+    static const char *timed[] = {
+        "a + b;",
+        "a * b - c;",
+        "(a + b) * (c - d) / 7;",
+        "a * 3 + b * 5 < c * 7 + 11 == 1;",
+        "(b ^ 2 + a / (c + 1)) * (2 + 3);"
+    };
+    long rows = argc > 1 ? atol(argv[1]) : 1000000;
+    table_t table;
+    symbols_t symbols;
+    char text[4096];
+    long long *columns[COLUMNS];
+    long row;
+    int i;
+
+    srand(argc > 2 ? atoi(argv[2]) : 1);
+    if (rows < 1) {
+        fprintf(stderr, "Usage: column_bench [rows] [seed]\n");
+        return 1;
+    }
+    output_memory(&diagnostics);
+    symbols_init(&symbols);
+    table_init(&table);
+    table.count = COLUMNS;
+    table.rows = rows;
+    table.columns = (const long long **) columns;
+    for (i = 0; i < COLUMNS; i++) {
+        columns[i] = malloc(rows * sizeof(long long));
+        if (columns[i] == NULL) {
+            fprintf(stderr, "out of memory for %ld rows\n", rows);
+            return 1;
+        }
+        for (row = 0; row < rows; row++) {
+            columns[i][row] = random_value(0);
+        }
+        symbols_intern(&symbols, names[i], 1);
+        symbols.defined[i] = 1;
+    }
+
+    for (i = 0; i < (int) (sizeof(timed) / sizeof(timed[0])); i++) {
+        run(timed[i], &table, &symbols, 1);
+    }
+
+    table.rows = rows < 10000 ? rows : 10000;
+    for (i = 0; i < COLUMNS; i++) {
+        for (row = 0; row < table.rows; row++) {
+            columns[i][row] = random_value(1);
+        }
+    }
+    for (i = 0; i < RANDOM_EXPRESSIONS; i++) {
+        strcpy(random_expression(text, 1 + rand() % 6), ";");
+        run(text, &table, &symbols, 0);
+    }
+    printf("%d random expressions agreed on %ld rows\n", RANDOM_EXPRESSIONS, table.rows);
+
+    for (i = 0; i < COLUMNS; i++) {
+        free(columns[i]);
+    }
+    symbols_free(&symbols);
+    free(diagnostics.data);
+    return 0;
+}
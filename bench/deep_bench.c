@@ -0,0 +1,204 @@
+/**
+ * deep_bench.c - Parses pathologically deep statements with the recursive
+ * parser of ast.c and with the iterative one, at growing depths.
+ *
+ * The shapes are parentheses nested n deep, n terms chained with +, and a
+ * chain of n exponents, which nests like parentheses since ^ groups to the
+ * right. The recursive parser runs in a child process, so running out of
+ * stack shows up as a crash in the table instead of ending the benchmark.
+ * The iterative parser is given a limit above every depth, and each tree
+ * it builds is checked against the recursive one while they both survive.
+ *
+ * Build: gcc -O2 -I.. -o deep_bench deep_bench.c ../Tokenizer.c ../Parser.c ../Symbols.c ../Ast.c ../Iterative.c ../Arena.c ../Scan.c ../Output.c -lm
+ * Usage: deep_bench [largest depth]
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Parser.h"
+#include "Ast.h"
+#include "Iterative.h"
+
+static output_t diagnostics; // where syntax errors would be reported
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Builds one of the deep shapes
+ * @param shape 0 for parentheses, 1 for a chain of +, 2 for a chain of ^
+ * @param depth how deep
+ * @return the statement, to be freed by the caller
+ */
+static char *deep(int shape, int depth) {
+    char *text = malloc(2 * (size_t) depth + 8);
+    char *pos = text;
+    int i;
+
+    if (shape == 0) {
+        memset(pos, '(', depth);
+        pos += depth;
+        *pos++ = '1';
+        memset(pos, ')', depth);
+        pos += depth;
+    } else {
+        *pos++ = '1';
+        for (i = 0; i < depth; i++) {
+            *pos++ = shape == 1 ? '+' : '^';
+            *pos++ = '1';
+        }
+    }
+    strcpy(pos, ";");
+    return text;
+}
+
+/**
+ * Parses a statement with one of the parsers
+ * @param stack the stack of the iterative parser, NULL for the recursive one
+ * @return the root of the statement
+ */
+static int parse(ast_t *ast, parse_stack_t *stack, const char *text) {
+    context_t ctx;
+    token_t token;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = &diagnostics;
+    ctx.line = text;
+    ast_reset(ast);
+    get_token(&ctx, &token);
+    if (stack == NULL) {
+        return parse_bexpr(&ctx, ast, &token);
+    }
+    return parse_iterative(&ctx, ast, stack, &token);
+}
+
+/**
+ * Times the recursive parser in a child process
+ * @param text the statement
+ * @param tree set to a copy of the tree it built
+ * @return the seconds it took, or -1 if it crashed
+ */
+static double recursive(const char *text, ast_t *tree) {
+    int pipes[2];
+    pid_t child;
+    int status;
+    double seconds = -1;
+
+    if (pipe(pipes) != 0 || (child = fork()) < 0) {
+        perror("deep_bench");
+        exit(1);
+    }
+    if (child == 0) {
+        ast_t ast;
+        double start;
+
+        close(pipes[0]);
+        ast_init(&ast);
+        start = now();
+        parse(&ast, NULL, text);
+        seconds = now() - start;
+        if (write(pipes[1], &seconds, sizeof(seconds)) != sizeof(seconds)
+            || write(pipes[1], &ast.count, sizeof(ast.count)) != sizeof(ast.count)
+            || write(pipes[1], ast.nodes, ast.count * sizeof(node_t))
+               != (ssize_t) (ast.count * sizeof(node_t))) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+
+    close(pipes[1]);
+    ast_reset(tree);
+    if (read(pipes[0], &seconds, sizeof(seconds)) != sizeof(seconds)) {
+        seconds = -1;
+    } else {
+        size_t size, got = 0;
+        ssize_t n;
+
+        if (read(pipes[0], &tree->count, sizeof(tree->count)) != sizeof(tree->count)) {
+            tree->count = 0;
+        }
+        size = tree->count * sizeof(node_t);
+        free(tree->nodes);
+        tree->nodes = malloc(size + 1);
+        tree->capacity = tree->count;
+        while (got < size && (n = read(pipes[0], (char *) tree->nodes + got, size - got)) > 0) {
+            got += n;
+        }
+    }
+    close(pipes[0]);
+    waitpid(child, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return -1;
+    }
+    return seconds;
+}
+
+int main(int argc, char *argv[]) {
+    static const char *shapes[] = {"( nested", "+ chained", "^ chained"};
+    int largest = argc > 1 ? atoi(argv[1]) : 1000000;
+    parse_stack_t stack;
+    ast_t ast, tree;
+    int shape, depth, root;
+
+    output_fd(&diagnostics, 2);
+    parse_stack_init(&stack, largest + 1);
+    ast_init(&ast);
+    ast_init(&tree);
+
+    printf("%-10s %10s %14s %14s %10s\n", "shape", "depth", "recursive", "iterative", "stack");
+    for (shape = 0; shape < 3; shape++) {
+        for (depth = 1000; depth <= largest; depth *= 10) {
+            char *text = deep(shape, depth);
+            double start, iterative_time, recursive_time;
+
+            recursive_time = recursive(text, &tree);
+
+            //start from an empty stack so its size is this statement's
+            parse_stack_free(&stack);
+            start = now();
+            root = parse(&ast, &stack, text);
+            iterative_time = now() - start;
+            if (root == NO_NODE) {
+                printf("%s at depth %d does not parse\n", shapes[shape], depth);
+                exit(1);
+            }
+            if (recursive_time >= 0 && (tree.count != ast.count
+                || memcmp(tree.nodes, ast.nodes, ast.count * sizeof(node_t)) != 0)) {
+                printf("%s at depth %d: the trees differ\n", shapes[shape], depth);
+                exit(1);
+            }
+
+            if (recursive_time < 0) {
+                printf("%-10s %10d %14s", shapes[shape], depth, "crashed");
+            } else {
+                printf("%-10s %10d %11.2f ms", shapes[shape], depth, recursive_time * 1e3);
+            }
+            printf(" %11.2f ms %7.1f MB\n", iterative_time * 1e3,
+                   stack.capacity * sizeof(frame_t) / 1048576.0);
+            fflush(stdout);
+            free(text);
+        }
+    }
+
+    parse_stack_free(&stack);
+    ast_free(&tree);
+    ast_free(&ast);
+    output_flush(&diagnostics);
+    return 0;
+}
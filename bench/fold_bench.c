@@ -0,0 +1,301 @@
+/**
+ * fold_bench.c - Checks that optimize.c never changes a value, then times
+ * statements with and without it.
+ *
+ * The check evaluates random statements before and after optimizing, with
+ * the tree walker and the VM, and compares every shift and square node
+ * against the * , / and ^ it stands for over edge case operands. It exits
+ * with 1 on the first difference.
+ *
+ * Each line is evaluated once by the interpreter, so the timing covers
+ * parsing, optimizing and evaluating together, as well as evaluating an
+ * already optimized tree many times.
+ *
+ * Build: gcc -O2 -I.. -o fold_bench fold_bench.c ../Tokenizer.c ../Parser.c ../Symbols.c ../Ast.c ../Optimize.c ../Vm.c ../Arena.c ../Scan.c ../Output.c -lm
+ * Usage: fold_bench [statements] [iterations]
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Parser.h"
+#include "Ast.h"
+#include "Optimize.h"
+#include "Vm.h"
+
+static output_t diagnostics; // where syntax errors would be reported
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Writes a random number, often 0, 1, 2 or a power of two so the
+ * identities and strength reductions come up
+ * @param pos where to write it
+ * @param nonzero 1 if the number may not be 0
+ * @return the number of characters written
+ */
+static int random_num(char *pos, int nonzero) {
+    int value;
+
+    switch (rand() % 5) {
+    case 0:
+        value = rand() % 3;
+        break;
+    case 1:
+        value = 1 << rand() % 31;
+        break;
+    case 2:
+        value = rand() % 100;
+        break;
+    default:
+        value = rand();
+        break;
+    }
+    if (nonzero && value == 0) {
+        value = 1;
+    }
+    return sprintf(pos, "%d", value);
+}
+
+/**
+ * Writes a random expression. Every divisor is a literal that is not 0,
+ * so no statement traps.
+ * @param pos where to write it
+ * @param depth how many more operators may be nested
+ * @return the number of characters written
+ */
+static int random_expr(char *pos, int depth) {
+    static const char *ops[] = {" + ", " - ", " * ", " / ", " ^ ", " < ", " <= ",
+                                " > ", " >= ", " == ", " != "};
+    const char *op;
+    char *start = pos;
+
+    if (depth == 0 || rand() % 4 == 0) {
+        return random_num(pos, 0);
+    }
+    op = ops[rand() % 11];
+    *pos++ = '(';
+    pos += random_expr(pos, depth - 1);
+    pos += sprintf(pos, "%s", op);
+    if (strcmp(op, " / ") == 0) {
+        pos += random_num(pos, 1);
+    } else if (strcmp(op, " ^ ") == 0) {
+        pos += sprintf(pos, "%d", rand() % 4);
+    } else {
+        pos += random_expr(pos, depth - 1);
+    }
+    *pos++ = ')';
+    return pos - start;
+}
+
+/**
+ * Parses a statement into an arena
+ * @return the root of the statement
+ */
+static int parse(ast_t *ast, const char *text) {
+    context_t ctx;
+    token_t token;
+    int root;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = &diagnostics;
+    ctx.line = text;
+    ast_reset(ast);
+    get_token(&ctx, &token);
+    root = parse_bexpr(&ctx, ast, &token);
+    if (root == NO_NODE) {
+        fprintf(stderr, "%s does not parse\n", text);
+        exit(1);
+    }
+    return root;
+}
+
+/**
+ * Evaluates random statements before and after optimizing
+ * @param count how many statements
+ */
+static void check_statements(int count) {
+    char text[8192];
+    ast_t ast;
+    program_t program;
+    int root, before, after, run;
+    int i, length;
+
+    ast_init(&ast);
+    program_init(&program);
+    for (i = 0; i < count; i++) {
+        length = random_expr(text, 6);
+        strcpy(text + length, ";");
+        root = parse(&ast, text);
+        before = ast_eval(&ast, root);
+        root = optimize(&ast, root);
+        after = ast_eval(&ast, root);
+        compile(&program, &ast, root);
+        run = vm_run(&program);
+        if (before != after || before != run) {
+            printf("%s is %d, optimized %d, on the VM %d\n", text, before, after, run);
+            exit(1);
+        }
+    }
+    printf("%d random statements give the same values optimized\n", count);
+    program_free(&program);
+    ast_free(&ast);
+}
+
+/**
+ * Evaluates a node made by optimize.c and the node it replaces, with both
+ * engines, on the same operands
+ * @return 1 if all four values are the same
+ */
+static int same(enum node_kind reduced, enum node_kind original, int x, int k, int operand) {
+    ast_t ast;
+    program_t program;
+    int a, b, values[4];
+
+    ast_init(&ast);
+    program_init(&program);
+    a = reduced == SQUARE_NODE
+        ? ast_node(&ast, SQUARE_NODE, ast_node(&ast, NUM_NODE, x, NO_NODE), NO_NODE)
+        : ast_node(&ast, reduced, ast_node(&ast, NUM_NODE, x, NO_NODE),
+                   ast_node(&ast, NUM_NODE, k, NO_NODE));
+    b = ast_node(&ast, original, ast_node(&ast, NUM_NODE, x, NO_NODE),
+                 ast_node(&ast, NUM_NODE, operand, NO_NODE));
+    values[0] = ast_eval(&ast, a);
+    values[1] = ast_eval(&ast, b);
+    compile(&program, &ast, a);
+    values[2] = vm_run(&program);
+    compile(&program, &ast, b);
+    values[3] = vm_run(&program);
+    program_free(&program);
+    ast_free(&ast);
+    return values[0] == values[1] && values[0] == values[2] && values[0] == values[3];
+}
+
+/**
+ * Compares the shift and square nodes with what they replace
+ */
+static void check_reductions(void) {
+    static const int edges[] = {0, 1, -1, 2, -2, 3, -3, 7, -7, 46340, -46340, 46341, -46341,
+                                65535, -65536, INT_MAX, INT_MIN, INT_MAX - 1, INT_MIN + 1};
+    int values[sizeof(edges) / sizeof(edges[0]) + 64];
+    int count = 0;
+    int i, k;
+
+    for (i = 0; i < (int) (sizeof(edges) / sizeof(edges[0])); i++) {
+        values[count++] = edges[i];
+    }
+    for (i = 0; i < 64; i++) {
+        values[count++] = rand() - rand();
+    }
+
+    for (i = 0; i < count; i++) {
+        if (!same(SQUARE_NODE, EXPON_NODE, values[i], 0, 2)) {
+            printf("square(%d) differs from %d ^ 2\n", values[i], values[i]);
+            exit(1);
+        }
+        for (k = 1; k <= 30; k++) {
+            if (!same(SHIFT_LEFT_NODE, MULT_NODE, values[i], k, 1 << k)) {
+                printf("%d << %d differs from %d * %d\n", values[i], k, values[i], 1 << k);
+                exit(1);
+            }
+            if (!same(SHIFT_RIGHT_NODE, DIV_NODE, values[i], k, 1 << k)) {
+                printf("%d >> %d differs from %d / %d\n", values[i], k, values[i], 1 << k);
+                exit(1);
+            }
+        }
+    }
+    printf("shift and square nodes match * / and ^ on %d operands\n", count);
+}
+
+/**
+ * Times one statement with and without optimizing
+ * @param name the name of the workload
+ * @param text the statement
+ * @param iterations how many times it is run
+ */
+static void run(const char *name, const char *text, int iterations) {
+    ast_t ast;
+    int root = 0;
+    int value = 0;
+    int i;
+    double start, plain, folded, plain_eval, folded_eval;
+
+    ast_init(&ast);
+
+    start = now();
+    for (i = 0; i < iterations; i++) {
+        value += ast_eval(&ast, parse(&ast, text));
+    }
+    plain = now() - start;
+
+    start = now();
+    for (i = 0; i < iterations; i++) {
+        value += ast_eval(&ast, optimize(&ast, parse(&ast, text)));
+    }
+    folded = now() - start;
+
+    root = parse(&ast, text);
+    start = now();
+    for (i = 0; i < iterations; i++) {
+        value += ast_eval(&ast, root);
+    }
+    plain_eval = now() - start;
+
+    root = optimize(&ast, root);
+    start = now();
+    for (i = 0; i < iterations; i++) {
+        value += ast_eval(&ast, root);
+    }
+    folded_eval = now() - start;
+
+    printf("%s (%d nodes)\n", name, ast.count);
+    printf("  parse and evaluate:          %10.0f ns/statement\n", plain / iterations * 1e9);
+    printf("  parse, optimize and evaluate:%10.0f ns/statement (%.2fx)\n",
+           folded / iterations * 1e9, folded / plain);
+    printf("  evaluate the tree again:     %10.0f ns/statement\n", plain_eval / iterations * 1e9);
+    printf("  evaluate the optimized tree: %10.0f ns/statement (%.2fx)\n",
+           folded_eval / iterations * 1e9, folded_eval / plain_eval);
+    if (value == 42) {
+        printf("\n"); // keeps the loops from being optimized away
+    }
+    ast_free(&ast);
+}
+
+int main(int argc, char *argv[]) {
+    int statements = argc > 1 ? atoi(argv[1]) : 100000;
+    int iterations = argc > 2 ? atoi(argv[2]) : 200000;
+    char text[8192];
+    int length;
+
+    output_fd(&diagnostics, 2);
+    srand(17);
+
+    check_statements(statements);
+    check_reductions();
+
+    run("short, 3 terms", "12 * 34 + 5;", iterations);
+    run("identities, x * 1 + 0 ^ 1", "(12 * 1 + 0) ^ 1 - 0;", iterations);
+    do {
+        length = random_expr(text, 8);
+    } while (length < 400);
+    strcpy(text + length, ";");
+    run("random, depth 8", text, iterations / 10);
+
+    output_flush(&diagnostics);
+    return 0;
+}
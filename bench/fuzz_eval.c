@@ -0,0 +1,712 @@
+/**
+ * fuzz_eval.c - Differential fuzzer. Runs each line through every way
+ * the interpreter can evaluate it and checks the results against an
+ * evaluator written separately from the grammar, so a change made for
+ * speed cannot quietly change what a line prints.
+ *
+ * The reference tokenizes a line and evaluates it by precedence climbing,
+ * with the quirks of the interpreter spelled out instead of inherited:
+ * int arithmetic wraps, a literal too big for a long saturates before it
+ * is narrowed to int, and ^ is pow() truncated to int, with anything out
+ * of range becoming INT_MIN as the conversion does on x86, and whatever
+ * token follows a statement ends it, so "1 2;" has the value 1 as it
+ * always has. Variables start out undefined on every line, so each input
+ * stands on its own, and reading one that has no value yet is a name
+ * error that ends the line. When every statement of a line is valid it
+ * knows the exact output; otherwise it knows the output of the statements
+ * before the first bad one, and leaves what follows to the engines
+ * agreeing.
+ *
+ * Every line is run with each of the configurations in the table below,
+ * and their outputs must agree with the reference and with each other.
+ * A new fast path gets checked by adding a row. Lines nested deeper than
+ * the recursive parsers can take are only run with the iterative one.
+ *
+ * A mismatch prints the line and the outputs and aborts, which is what
+ * libFuzzer and AFL record as a crash. Sanitizers report the rest; signed
+ * overflow and float to int conversion are left out of them, since
+ * wrapping and the conversion of pow() are the behaviour being checked.
+ *
+ * Build:  gcc -O1 -g -fsanitize=address,undefined -fno-sanitize=signed-integer-overflow,float-cast-overflow
+ *             -fno-sanitize-recover=all -I.. -o fuzz_eval fuzz_eval.c ../Library.c ../Tokenizer.c ../Parser.c
+ *             ../Ast.c ../Vm.c ../Arith.c ../Big.c ../Iterative.c ../Optimize.c ../Symbols.c ../Cache.c ../Arena.c
+ *             ../Scan.c ../Stats.c ../Output.c -lm
+ *         add -DFUZZ_LIBFUZZER and use clang -fsanitize=fuzzer,... for libFuzzer
+ * Usage:  fuzz_eval [lines] [seed]      random lines from the grammar
+ *         fuzz_eval file...             each file is one input, as for afl-fuzz ... -- fuzz_eval @@
+ *
+ * @version 10/17/2026
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+
+#include "Library.h"
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Parser.h"
+#include "Ast.h"
+#include "Big.h"
+#include "Arith.h"
+#include "Vm.h"
+#include "Iterative.h"
+#include "Cache.h"
+#include "Arena.h"
+#include "Stats.h"
+#include "Input.h"
+#include "Symbols.h"
+#include "Interpreter.h"
+
+#define MAX_LINE 65536    // longest input line that is checked
+#define MAX_NESTING 1000  // deepest ( and ^ the recursive parsers are given
+#define MAX_GENERATED 4000
+#define REF_VARIABLES 64  // most names the reference keeps on a line
+
+/* -------------------------------------------------------------------- */
+/* the reference                                                        */
+
+/* tokens of the reference, kept apart from enum token_kind on purpose */
+enum ref_kind {
+    R_NUM, R_PLUS, R_MINUS, R_STAR, R_SLASH, R_LPAREN, R_RPAREN, R_CARET,
+    R_LT, R_LE, R_GT, R_GE, R_EQ, R_NE, R_SEMI, R_NAME, R_ASSIGN, R_BAD
+};
+
+typedef struct ref_token {
+    enum ref_kind kind;
+    int value;
+    int wide;    // 1 if the literal did not fit in an int
+    const char *name; // where the name of an R_NAME is in the line
+    int length;
+} ref_token_t;
+
+/* a variable of the reference, looked up by name every time */
+typedef struct ref_variable {
+    const char *name;
+    int length;
+    int defined;
+    int value;
+} ref_variable_t;
+
+/* a statement being evaluated by the reference */
+typedef struct ref {
+    const ref_token_t *tokens;
+    int count;
+    int pos;
+    int error;   // 1 once the statement is not valid
+    int status;  // the first arithmetic error of the statement, ARITH_OK if none
+    int wide;    // 1 if some operation did not fit in an int
+    int depth;
+    const ref_token_t *undefined; // the name that was read without a value
+    ref_variable_t variables[REF_VARIABLES];
+    int variable_count;
+} ref_t;
+
+/**
+ * Splits a line into tokens the way the grammar defines them
+ * @return the number of tokens
+ */
+static int ref_lex(const char *line, ref_token_t *tokens) {
+    int count = 0;
+    const char *p = line;
+
+    while (*p != '\0' && *p != '\n') {
+        ref_token_t *t = &tokens[count];
+
+        if (*p == ' ' || *p == '\t' || *p == '\r') {
+            p++;
+            continue;
+        }
+        if (*p >= '0' && *p <= '9') {
+            //saturates at LONG_MAX, then keeps the low 32 bits
+            uint64_t value = 0;
+            while (*p >= '0' && *p <= '9') {
+                if (value > ((uint64_t) LONG_MAX - (*p - '0')) / 10) {
+                    value = LONG_MAX;
+                } else if (value != LONG_MAX) {
+                    value = value * 10 + (*p - '0');
+                }
+                p++;
+            }
+            t->kind = R_NUM;
+            t->value = (int) (uint32_t) value;
+            t->wide = value > INT_MAX;
+        } else if ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') || *p == '_') {
+            t->kind = R_NAME;
+            t->name = p;
+            while ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') || *p == '_'
+                   || (*p >= '0' && *p <= '9')) {
+                p++;
+            }
+            t->length = p - t->name;
+        } else if ((p[0] == '<' || p[0] == '>' || p[0] == '=' || p[0] == '!') && p[1] == '=') {
+            t->kind = p[0] == '<' ? R_LE : p[0] == '>' ? R_GE : p[0] == '=' ? R_EQ : R_NE;
+            p += 2;
+        } else {
+            switch (*p) {
+            case '+': t->kind = R_PLUS; break;
+            case '-': t->kind = R_MINUS; break;
+            case '*': t->kind = R_STAR; break;
+            case '/': t->kind = R_SLASH; break;
+            case '(': t->kind = R_LPAREN; break;
+            case ')': t->kind = R_RPAREN; break;
+            case '^': t->kind = R_CARET; break;
+            case '<': t->kind = R_LT; break;
+            case '>': t->kind = R_GT; break;
+            case ';': t->kind = R_SEMI; break;
+            case '=': t->kind = R_ASSIGN; break;
+            default: t->kind = R_BAD; break;
+            }
+            p++;
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @return the kind of the current token, R_BAD past the end
+ */
+static enum ref_kind peek(ref_t *ref) {
+    return ref->pos < ref->count ? ref->tokens[ref->pos].kind : R_BAD;
+}
+
+/**
+ * Finds a variable by name, adding it undefined the first time
+ * @return the variable, or NULL if there are too many to keep
+ */
+static ref_variable_t *ref_variable(ref_t *ref, const ref_token_t *token) {
+    ref_variable_t *variable;
+    int i;
+
+    for (i = 0; i < ref->variable_count; i++) {
+        variable = &ref->variables[i];
+        if (variable->length == token->length && memcmp(variable->name, token->name, token->length) == 0) {
+            return variable;
+        }
+    }
+    if (ref->variable_count == REF_VARIABLES) {
+        return NULL;
+    }
+    variable = &ref->variables[ref->variable_count++];
+    variable->name = token->name;
+    variable->length = token->length;
+    variable->defined = 0;
+    return variable;
+}
+
+/**
+ * Applies a binary operator in wrapping int arithmetic
+ */
+static int apply(ref_t *ref, enum ref_kind op, int a, int b) {
+    int64_t wide;
+
+    switch (op) {
+    case R_PLUS: wide = (int64_t) a + b; break;
+    case R_MINUS: wide = (int64_t) a - b; break;
+    case R_STAR: wide = (int64_t) a * b; break;
+    case R_SLASH:
+        if (b == 0 || (a == INT_MIN && b == -1)) {
+            //the wider arithmetics divide INT_MIN by -1 without an error
+            ref->wide |= b != 0;
+            if (ref->status == ARITH_OK) {
+                ref->status = b == 0 ? ARITH_DIVIDE_BY_ZERO : ARITH_OVERFLOW;
+            }
+            return 0;
+        }
+        return a / b;
+    case R_CARET: {
+        double p = pow(a, b);
+        if (!(p >= -2147483648.0 && p < 2147483648.0)) {
+            ref->wide = 1;
+            return INT_MIN;
+        }
+        return (int) p;
+    }
+    case R_LT: return a < b;
+    case R_LE: return a <= b;
+    case R_GT: return a > b;
+    case R_GE: return a >= b;
+    case R_EQ: return a == b;
+    default: return a != b;
+    }
+    if (wide < INT_MIN || wide > INT_MAX) {
+        ref->wide = 1;
+    }
+    return (int) (uint32_t) (uint64_t) wide;
+}
+
+static int ref_expr(ref_t *ref);
+
+/**
+ * <factor> ::= ( <expr> ) [ ^ <factor> ] | <num> [ ^ <factor> ] | <name> [ ^ <factor> ]
+ */
+static int ref_factor(ref_t *ref) {
+    int base;
+
+    if (++ref->depth > MAX_NESTING) {
+        ref->error = 1;
+        return 0;
+    }
+    if (peek(ref) == R_NUM) {
+        ref->wide |= ref->tokens[ref->pos].wide;
+        base = ref->tokens[ref->pos++].value;
+    } else if (peek(ref) == R_NAME) {
+        ref_variable_t *variable = ref_variable(ref, &ref->tokens[ref->pos]);
+
+        if (variable == NULL || !variable->defined) {
+            //past REF_VARIABLES names the reference gives up on the line
+            ref->undefined = variable != NULL ? &ref->tokens[ref->pos] : NULL;
+            ref->error = 1;
+            return 0;
+        }
+        base = variable->value;
+        ref->pos++;
+    } else if (peek(ref) == R_LPAREN) {
+        ref->pos++;
+        base = ref_expr(ref);
+        if (ref->error || peek(ref) != R_RPAREN) {
+            ref->error = 1;
+            return 0;
+        }
+        ref->pos++;
+    } else {
+        ref->error = 1;
+        return 0;
+    }
+    if (peek(ref) == R_CARET) {
+        int exponent;
+
+        ref->pos++;
+        exponent = ref_factor(ref);
+        if (ref->error) {
+            return 0;
+        }
+        base = apply(ref, R_CARET, base, exponent);
+    }
+    ref->depth--;
+    return base;
+}
+
+/**
+ * Operators of each level, loosest first: + - then * / then comparisons
+ * @return 1 if the kind is an operator of the level
+ */
+static int of_level(int level, enum ref_kind kind) {
+    if (level == 0) {
+        return kind == R_PLUS || kind == R_MINUS;
+    }
+    if (level == 1) {
+        return kind == R_STAR || kind == R_SLASH;
+    }
+    return kind >= R_LT && kind <= R_NE;
+}
+
+/**
+ * Evaluates the left-grouping operators of a level and the levels below
+ */
+static int ref_level(ref_t *ref, int level) {
+    int left = level == 2 ? ref_factor(ref) : ref_level(ref, level + 1);
+
+    while (!ref->error && of_level(level, peek(ref))) {
+        enum ref_kind op = ref->tokens[ref->pos++].kind;
+        int right = level == 2 ? ref_factor(ref) : ref_level(ref, level + 1);
+
+        if (ref->error) {
+            return 0;
+        }
+        left = apply(ref, op, left, right);
+    }
+    return left;
+}
+
+static int ref_expr(ref_t *ref) {
+    return ref_level(ref, 0);
+}
+
+/* what the reference expects of a line */
+typedef struct expected {
+    output_t out;     // the exact output, or the part before the first error
+    int complete;     // 1 if every statement is valid and out is all of it
+    int wide;         // 1 if some value did not fit in an int
+    int deep;         // 1 if the line nests deeper than MAX_NESTING
+} expected_t;
+
+/**
+ * Works out what running a line should print
+ */
+static void ref_line(const char *line, size_t length, ref_token_t *tokens, expected_t *expected) {
+    ref_t ref;
+    int nesting = 0, i;
+
+    memset(&ref, 0, sizeof(ref));
+    ref.tokens = tokens;
+    ref.count = ref_lex(line, tokens);
+    expected->out.size = 0;
+    expected->complete = 1;
+    expected->wide = 0;
+    expected->deep = 0;
+    output_write(&expected->out, line, length);
+
+    for (i = 0; i < ref.count; i++) {
+        nesting += tokens[i].kind == R_LPAREN || tokens[i].kind == R_CARET;
+    }
+    if (nesting > MAX_NESTING) {
+        expected->deep = 1;
+    }
+
+    while (ref.pos < ref.count) {
+        ref_variable_t *target = NULL;
+        int start = ref.pos;
+        int open = 0;
+        int value;
+
+        ref.depth = 0;
+        ref.status = ARITH_OK;
+        if (peek(&ref) == R_NAME && ref.pos + 1 < ref.count && tokens[ref.pos + 1].kind == R_ASSIGN) {
+            target = ref_variable(&ref, &tokens[ref.pos]);
+            ref.pos += 2;
+            if (target == NULL) {
+                expected->complete = 0;
+                break;
+            }
+        }
+        value = ref_expr(&ref);
+        if (ref.undefined != NULL) {
+            //the rest of the line is skipped, only its lexical errors are
+            //written, each parenthesis still open reports a missing ')',
+            //and a line that does not end in ';' a missing ';' as well
+            output_string(&expected->out, "===> '");
+            output_write(&expected->out, ref.undefined->name, ref.undefined->length);
+            output_string(&expected->out, "'\nName Error: not defined\n");
+            for (i = start; i < ref.pos; i++) {
+                open += (tokens[i].kind == R_LPAREN) - (tokens[i].kind == R_RPAREN);
+            }
+            for (i = ref.pos; i < ref.count; i++) {
+                if (tokens[i].kind == R_BAD) {
+                    expected->complete = 0;
+                }
+            }
+            if (open > 0) {
+                expected->complete = 0;
+            } else if (expected->complete && tokens[ref.count - 1].kind != R_SEMI) {
+                output_string(&expected->out, "===> ';' expected\nSyntax Error\n");
+            }
+            break;
+        }
+        //whatever token follows ends the statement, a missing ';' is let
+        //go, but not an '=', which only a name can be followed by
+        if (ref.error || ref.pos == ref.count || peek(&ref) == R_BAD || peek(&ref) == R_ASSIGN) {
+            expected->complete = 0;
+            break;
+        }
+        ref.pos++;
+        if (ref.status != ARITH_OK) {
+            //the statement has no value, and a variable it assigns keeps its own
+            output_string(&expected->out, "Syntax OK\n");
+            output_string(&expected->out, arith_message(ref.status));
+            output_string(&expected->out, "\n");
+            continue;
+        }
+        if (target != NULL) {
+            target->defined = 1;
+            target->value = value;
+        }
+        output_string(&expected->out, "Syntax OK\nValue is ");
+        output_int(&expected->out, value);
+        output_string(&expected->out, "\n");
+    }
+    expected->wide = ref.wide;
+}
+
+/* -------------------------------------------------------------------- */
+/* the interpreter                                                      */
+
+/* one way of running a line */
+typedef struct config {
+    const char *name;
+    enum engine engine;
+    enum arith arith;
+    int iterative;
+    int optimize;
+    int cache;       // run the line twice with the cache on
+} config_t;
+
+static const config_t configs[] = {
+    {"direct",           DIRECT_ENGINE, INT_ARITH,     0, 0, 0},
+    {"ast",              AST_ENGINE,    INT_ARITH,     0, 0, 0},
+    {"vm",               VM_ENGINE,     INT_ARITH,     0, 0, 0},
+    {"direct iterative", DIRECT_ENGINE, INT_ARITH,     1, 0, 0},
+    {"vm -O",            VM_ENGINE,     INT_ARITH,     0, 1, 0},
+    {"ast -O iterative", AST_ENGINE,    INT_ARITH,     1, 1, 0},
+    {"direct cached",    DIRECT_ENGINE, INT_ARITH,     0, 0, 1},
+    {"checked",          AST_ENGINE,    CHECKED_ARITH, 0, 0, 0},
+    {"big",              AST_ENGINE,    BIG_ARITH,     0, 0, 0},
+};
+#define CONFIGS ((int) (sizeof(configs) / sizeof(configs[0])))
+
+static worker_t workers[CONFIGS];
+static output_t outputs[CONFIGS];
+static expected_t expected;
+static ref_token_t *tokens;
+static char *line;
+
+/**
+ * Sets up a worker for each configuration
+ */
+static void setup(void) {
+    int i;
+
+    for (i = 0; i < CONFIGS; i++) {
+        output_memory(&outputs[i]);
+        worker_init(&workers[i], configs[i].engine, &outputs[i]);
+        workers[i].arith = configs[i].arith;
+        workers[i].iterative = configs[i].iterative;
+        workers[i].optimize = configs[i].optimize;
+        if (configs[i].cache) {
+            worker_cache(&workers[i], 1048576);
+        }
+    }
+    output_memory(&expected.out);
+    tokens = malloc((MAX_LINE + 1) * sizeof(ref_token_t));
+    line = malloc(MAX_LINE + 2);
+    if (tokens == NULL || line == NULL) {
+        fprintf(stderr, "ERROR: out of memory\n");
+        exit(1);
+    }
+}
+
+/**
+ * Prints a mismatch and aborts
+ */
+static void mismatch(const char *why, int a, int b, size_t length) {
+    printf("MISMATCH: %s\nline: %.*s", why, (int) length, line);
+    if (a >= 0) {
+        printf("--- %s:\n%.*s", configs[a].name, (int) outputs[a].size, outputs[a].data);
+    } else {
+        printf("--- reference%s:\n%.*s", expected.complete ? "" : " (up to the first error)",
+               (int) expected.out.size, expected.out.data);
+    }
+    printf("--- %s:\n%.*s", configs[b].name, (int) outputs[b].size, outputs[b].data);
+    fflush(stdout);
+    abort();
+}
+
+/**
+ * @return 1 if the output of a configuration is what the reference expects
+ */
+static int as_expected(int i) {
+    output_t *out = &outputs[i];
+
+    if (expected.complete) {
+        return out->size == expected.out.size
+            && memcmp(out->data, expected.out.data, out->size) == 0;
+    }
+    return out->size >= expected.out.size
+        && memcmp(out->data, expected.out.data, expected.out.size) == 0;
+}
+
+/**
+ * Runs one line in every configuration that can take it and compares
+ * @param data the line, which need not end in a newline
+ * @param size its number of bytes
+ */
+static void check(const char *data, size_t size) {
+    size_t length = 0;
+    int first_int = -1;
+    int i;
+
+    //the line ends at its first '\n' or '\0', as in the input file
+    while (length < size && length < MAX_LINE && data[length] != '\n' && data[length] != '\0') {
+        length++;
+    }
+    memcpy(line, data, length);
+    line[length++] = '\n';
+    line[length] = '\0';
+
+    ref_line(line, length, tokens, &expected);
+
+    for (i = 0; i < CONFIGS; i++) {
+        const config_t *config = &configs[i];
+        int runs = config->cache ? 2 : 1;
+
+        if (expected.deep && !config->iterative) {
+            continue;
+        }
+        while (runs-- > 0) {
+            outputs[i].size = 0;
+            symbols_reset(&workers[i].symbols);
+            run_line(&workers[i], line, length);
+        }
+
+        if (config->arith == INT_ARITH) {
+            if (!as_expected(i)) {
+                mismatch("differs from the reference", -1, i, length);
+            }
+            if (first_int >= 0 && (outputs[i].size != outputs[first_int].size
+                || memcmp(outputs[i].data, outputs[first_int].data, outputs[i].size) != 0)) {
+                mismatch("engines differ", first_int, i, length);
+            }
+            if (first_int < 0) {
+                first_int = i;
+            }
+        } else if (!expected.wide && !expected.deep && !as_expected(i)) {
+            //every value fits in an int, so the wider arithmetics agree with it
+            mismatch("differs from the reference", -1, i, length);
+        }
+    }
+
+    //big only overflows far past checked, so they agree wherever checked does
+    if (!expected.deep && memmem(outputs[CONFIGS - 2].data, outputs[CONFIGS - 2].size, "overflow", 8) == NULL
+        && (outputs[CONFIGS - 2].size != outputs[CONFIGS - 1].size
+            || memcmp(outputs[CONFIGS - 2].data, outputs[CONFIGS - 1].data, outputs[CONFIGS - 1].size) != 0)) {
+        mismatch("checked and big differ", CONFIGS - 2, CONFIGS - 1, length);
+    }
+}
+
+#ifdef FUZZ_LIBFUZZER
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static int ready;
+
+    if (!ready) {
+        setup();
+        ready = 1;
+    }
+    check((const char *) data, size);
+    return 0;
+}
+
+#else
+
+/* -------------------------------------------------------------------- */
+/* the generator                                                        */
+
+static uint64_t state = 1;
+
+/* the names lines assign and read */
+static const char *names[] = {"a", "b", "x1", "_t", "total"};
+#define NAMES ((unsigned) (sizeof(names) / sizeof(names[0])))
+
+static unsigned next(unsigned bound) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (unsigned) ((state * 0x2545f4914f6cdd1dULL) >> 33) % bound;
+}
+
+/**
+ * Appends a number, often an edge case of int or of the literal parser,
+ * or now and then a name
+ */
+static void gen_num(char *text, size_t *pos) {
+    static const char *edges[] = {"0", "1", "2", "46340", "46341", "65536", "2147483647",
+                                  "2147483648", "4294967295", "4294967296", "9223372036854775807",
+                                  "9223372036854775808", "99999999999999999999999", "007"};
+
+    if (next(6) == 0) {
+        *pos += sprintf(text + *pos, "%s", names[next(NAMES)]);
+    } else if (next(4) == 0) {
+        *pos += sprintf(text + *pos, "%s", edges[next(sizeof(edges) / sizeof(edges[0]))]);
+    } else {
+        *pos += sprintf(text + *pos, "%u", next(4) == 0 ? next(0x7fffffff) : next(20));
+    }
+}
+
+/**
+ * Appends a random expression from the grammar
+ */
+static void gen_expr(char *text, size_t *pos, int depth) {
+    static const char *ops[] = {"+", "-", "*", "/", "^", "<", "<=", ">", ">=", "==", "!="};
+
+    if (*pos > MAX_GENERATED - 200 || depth == 0 || next(3) == 0) {
+        if (depth > 0 && next(4) == 0) {
+            text[(*pos)++] = '(';
+            gen_expr(text, pos, depth - 1);
+            text[(*pos)++] = ')';
+        } else {
+            gen_num(text, pos);
+        }
+        return;
+    }
+    gen_expr(text, pos, depth - 1);
+    *pos += sprintf(text + *pos, next(2) ? " %s " : "%s", ops[next(11)]);
+    gen_expr(text, pos, depth - 1);
+}
+
+/**
+ * Writes a line of statements, half of them assignments, some of them
+ * broken on purpose
+ * @return its length
+ */
+static size_t gen_line(char *text) {
+    static const char noise[] = "$@#=!&a.;()^ \t";
+    int statements = next(4);
+    size_t pos = 0;
+    int i;
+
+    for (i = 0; i < statements; i++) {
+        if (next(2) == 0) {
+            pos += sprintf(text + pos, next(2) ? "%s = " : "%s=", names[next(NAMES)]);
+        }
+        gen_expr(text, &pos, 1 + next(6));
+        if (next(8) != 0) {
+            text[pos++] = ';';
+        }
+        text[pos++] = ' ';
+    }
+    //mutations: a stray character, a dropped character
+    if (pos > 0 && next(4) == 0) {
+        text[next(pos)] = noise[next(sizeof(noise) - 1)];
+    }
+    if (pos > 1 && next(8) == 0) {
+        size_t at = next(pos);
+        memmove(text + at, text + at + 1, pos - at - 1);
+        pos--;
+    }
+    return pos;
+}
+
+int main(int argc, char *argv[]) {
+    static char input[MAX_LINE];
+    char text[MAX_GENERATED + 1];
+    long lines = 20000, i;
+
+    setup();
+    if (argc > 1 && (argv[1][0] < '0' || argv[1][0] > '9')) {
+        //each file is one input
+        for (i = 1; i < argc; i++) {
+            FILE *file = fopen(argv[i], "rb");
+            size_t size;
+
+            if (file == NULL) {
+                fprintf(stderr, "fuzz_eval: could not open %s\n", argv[i]);
+                return 1;
+            }
+            size = fread(input, 1, MAX_LINE, file);
+            fclose(file);
+            check(input, size);
+        }
+        return 0;
+    }
+
+    if (argc > 1) {
+        lines = atol(argv[1]);
+    }
+    if (argc > 2) {
+        state = strtoull(argv[2], NULL, 10) * 0x9e3779b97f4a7c15ULL + 1;
+    }
+    for (i = 0; i < lines; i++) {
+        check(text, gen_line(text));
+    }
+    printf("%ld lines agree in %d configurations\n", lines, CONFIGS);
+    return 0;
+}
+
+#endif
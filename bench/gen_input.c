@@ -0,0 +1,250 @@
+/**
+ * gen_input.c - Writes the input of one benchmark workload. The same
+ * workload, line count and seed always give the same file, on any
+ * machine, since the numbers come from a generator of its own instead of
+ * rand().
+ *
+ * Workloads:
+ *   sums      long flat chains of + and -
+ *   parens    parentheses nested hundreds deep around a short sum
+ *   expon     chains of ^, which group to the right
+ *   compare   chains of < <= > >= == !=
+ *   lexerr    short statements full of characters that are not lexemes
+ *   mixed     a line of each of the above in turn
+ *   csv       a table for -x: a line of column names, then a row per line
+ *   columns   the same kind of table as a binary column file
+ *
+ * The number of lines and of tokens written is printed to stdout, so a
+ * harness can turn a run time into lines and tokens per second. For the
+ * tables they are the rows and the values.
+ *
+ * Build: gcc -O2 -o gen_input gen_input.c
+ * Usage: gen_input workload lines outputFile [seed]
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define SUM_TERMS 200     // operands in a line of sums
+#define PAREN_DEPTH 400   // nesting of a line of parens
+#define EXPON_TERMS 100   // operands in a line of expon
+#define COMPARE_TERMS 200 // operands in a line of compare
+#define TABLE_COLUMNS 4   // columns of csv and columns
+
+static const char *column_names[TABLE_COLUMNS] = {"a", "b", "c", "d"};
+static uint64_t state;  // the generator, xorshift64*
+static long tokens;     // tokens written so far
+
+/**
+ * @param bound how many values there may be
+ * @return the next number from 0 to bound - 1
+ */
+static unsigned next(unsigned bound) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (unsigned) ((state * 0x2545f4914f6cdd1dULL) >> 33) % bound;
+}
+
+/**
+ * Writes a token and a space
+ */
+static void token(FILE *out, const char *text) {
+    fputs(text, out);
+    fputc(' ', out);
+    tokens++;
+}
+
+/**
+ * Writes a number below bound and a space
+ */
+static void number(FILE *out, unsigned bound) {
+    fprintf(out, "%u ", next(bound));
+    tokens++;
+}
+
+/**
+ * Writes the end of a statement and of the line
+ */
+static void end(FILE *out) {
+    fputs(";\n", out);
+    tokens++;
+}
+
+static void sums(FILE *out) {
+    int i;
+
+    number(out, 100000);
+    for (i = 1; i < SUM_TERMS; i++) {
+        token(out, next(2) ? "+" : "-");
+        number(out, 100000);
+    }
+    end(out);
+}
+
+static void parens(FILE *out) {
+    int depth = PAREN_DEPTH / 2 + next(PAREN_DEPTH / 2);
+    int i;
+
+    for (i = 0; i < depth; i++) {
+        token(out, "(");
+    }
+    number(out, 1000);
+    token(out, "+");
+    number(out, 1000);
+    for (i = 0; i < depth; i++) {
+        token(out, ")");
+    }
+    end(out);
+}
+
+static void expon(FILE *out) {
+    int i;
+
+    //bases of 1 and 2 with exponents of 0 and 1 keep pow() out of infinity
+    number(out, 3);
+    for (i = 1; i < EXPON_TERMS; i++) {
+        token(out, "^");
+        number(out, 2);
+    }
+    end(out);
+}
+
+static void compare(FILE *out) {
+    static const char *ops[] = {"<", "<=", ">", ">=", "==", "!="};
+    int i;
+
+    number(out, 100);
+    for (i = 1; i < COMPARE_TERMS; i++) {
+        token(out, ops[next(6)]);
+        number(out, 100);
+    }
+    end(out);
+}
+
+static void lexerr(FILE *out) {
+    static const char *bad[] = {"$", "@", "#", "&", "$$", "@#"};
+    int statements = 1 + next(3);
+    int i;
+
+    for (i = 0; i < statements; i++) {
+        number(out, 1000);
+        token(out, "+");
+        if (next(2)) {
+            //every bad character is a token of its own
+            const char *text = bad[next(6)];
+            token(out, text);
+            tokens += strlen(text) - 1;
+        }
+        number(out, 1000);
+        fputs(i + 1 < statements ? "; " : ";\n", out);
+        tokens++;
+    }
+}
+
+/**
+ * @return a value of a table, below a million either way
+ */
+static int64_t value(void) {
+    tokens++;
+    return (int64_t) next(2000001) - 1000000;
+}
+
+static void csv(FILE *out, long rows) {
+    long i;
+    int j;
+
+    for (j = 0; j < TABLE_COLUMNS; j++) {
+        fprintf(out, j + 1 < TABLE_COLUMNS ? "%s," : "%s\n", column_names[j]);
+    }
+    for (i = 0; i < rows; i++) {
+        for (j = 0; j < TABLE_COLUMNS; j++) {
+            fprintf(out, j + 1 < TABLE_COLUMNS ? "%lld," : "%lld\n", (long long) value());
+        }
+    }
+}
+
+static void columns(FILE *out, long rows) {
+    static const char zeros[8];
+    uint32_t header[4] = {0, 1, TABLE_COLUMNS, 0}; // the layout of column_header_t in Column.h
+    uint64_t count = rows;
+    size_t size = sizeof(header) + sizeof(count);
+    long i;
+    int j;
+
+    memcpy(header, "ICOL", 4);
+    fwrite(header, sizeof(header), 1, out);
+    fwrite(&count, sizeof(count), 1, out);
+    for (j = 0; j < TABLE_COLUMNS; j++) {
+        uint32_t length = strlen(column_names[j]);
+
+        fwrite(&length, sizeof(length), 1, out);
+        fwrite(column_names[j], 1, length, out);
+        size += sizeof(length) + length;
+    }
+    fwrite(zeros, 1, -size & 7, out);
+    for (j = 0; j < TABLE_COLUMNS; j++) {
+        for (i = 0; i < rows; i++) {
+            int64_t v = value();
+
+            fwrite(&v, sizeof(v), 1, out);
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    static const struct {
+        const char *name;
+        void (*line)(FILE *out);
+    } workloads[] = {
+        {"sums", sums}, {"parens", parens}, {"expon", expon},
+        {"compare", compare}, {"lexerr", lexerr}
+    };
+    int count = sizeof(workloads) / sizeof(workloads[0]);
+    int workload = -1;
+    long lines, i;
+    FILE *out;
+
+    if (argc < 4 || (lines = atol(argv[2])) < 1) {
+        fprintf(stderr, "Usage: gen_input sums|parens|expon|compare|lexerr|mixed|csv|columns lines outputFile [seed]\n");
+        return 1;
+    }
+    for (i = 0; i < count; i++) {
+        if (strcmp(argv[1], workloads[i].name) == 0) {
+            workload = i;
+        }
+    }
+    if (workload < 0 && strcmp(argv[1], "mixed") != 0 && strcmp(argv[1], "csv") != 0
+        && strcmp(argv[1], "columns") != 0) {
+        fprintf(stderr, "gen_input: unknown workload %s\n", argv[1]);
+        return 1;
+    }
+    state = argc > 4 ? strtoull(argv[4], NULL, 10) : 0;
+    state = state * 0x9e3779b97f4a7c15ULL + 1;
+
+    out = fopen(argv[3], "w");
+    if (out == NULL) {
+        fprintf(stderr, "gen_input: could not open %s for writing\n", argv[3]);
+        return 1;
+    }
+    if (strcmp(argv[1], "csv") == 0) {
+        csv(out, lines);
+    } else if (strcmp(argv[1], "columns") == 0) {
+        columns(out, lines);
+    } else {
+        for (i = 0; i < lines; i++) {
+            workloads[workload >= 0 ? workload : i % count].line(out);
+        }
+    }
+    if (fclose(out) != 0) {
+        fprintf(stderr, "gen_input: could not write %s\n", argv[3]);
+        return 1;
+    }
+
+    printf("%ld %ld\n", lines, tokens);
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * harness.c - Runs the interpreter on every workload of gen_input and
+ * reports lines per second, tokens per second and peak resident memory,
+ * so a change to the tokenizer or the parser shows up as a number.
+ *
+ * Each input is generated once into a temporary directory. The
+ * interpreter then runs on it a number of times with its output going to
+ * /dev/null, and the fastest run is reported along with the largest peak
+ * RSS of the runs. Options after -- are passed to the interpreter, so the
+ * same table can be made for -e vm, -p iterative, -j 4 and so on.
+ *
+ * Build: gcc -O2 -o harness harness.c
+ * Usage: harness interpreter [lines] [runs] [-- interpreter options]
+ *        gen_input must be in the same directory as harness.
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+#define MAX_OPTIONS 32
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Runs the interpreter once
+ * @param argv its arguments
+ * @param rss set to its peak resident memory in kilobytes
+ * @return the seconds it took, or -1 if it failed
+ */
+static double run(char *argv[], long *rss) {
+    struct rusage usage;
+    double start = now();
+    int status;
+    pid_t child = fork();
+
+    if (child < 0) {
+        perror("harness");
+        exit(1);
+    }
+    if (child == 0) {
+        int null = open("/dev/null", O_WRONLY);
+
+        dup2(null, 1);
+        dup2(null, 2);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    if (wait4(child, &status, 0, &usage) < 0) {
+        perror("harness");
+        exit(1);
+    }
+    *rss = usage.ru_maxrss;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return -1;
+    }
+    return now() - start;
+}
+
+int main(int argc, char *argv[]) {
+    static const char *workloads[] = {"sums", "parens", "expon", "compare", "lexerr", "mixed"};
+    char generator[4096], directory[] = "/tmp/harness.XXXXXX", input[4200], command[8600];
+    char *args[MAX_OPTIONS + 4];
+    long lines = 20000;
+    int runs = 5;
+    int options = 0;
+    int w, i;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: harness interpreter [lines] [runs] [-- interpreter options]\n");
+        return 1;
+    }
+    for (i = 2; i < argc && strcmp(argv[i], "--") != 0; i++) {
+        if (i == 2) {
+            lines = atol(argv[i]);
+        } else if (i == 3) {
+            runs = atoi(argv[i]);
+        }
+    }
+    args[options++] = argv[1];
+    for (i++; i < argc && options <= MAX_OPTIONS; i++) {
+        args[options++] = argv[i];
+    }
+    if (lines < 1 || runs < 1) {
+        fprintf(stderr, "Usage: harness interpreter [lines] [runs] [-- interpreter options]\n");
+        return 1;
+    }
+
+    //gen_input sits next to this program
+    snprintf(generator, sizeof(generator), "%s", argv[0]);
+    if (strrchr(generator, '/') != NULL) {
+        strcpy(strrchr(generator, '/') + 1, "gen_input");
+    } else {
+        strcpy(generator, "./gen_input");
+    }
+    if (mkdtemp(directory) == NULL) {
+        perror("harness");
+        return 1;
+    }
+
+    printf("%-8s %8s %10s %8s %10s %12s %12s %9s\n",
+           "workload", "lines", "tokens", "MB", "best ms", "lines/s", "tokens/s", "peak RSS");
+    for (w = 0; w < (int) (sizeof(workloads) / sizeof(workloads[0])); w++) {
+        FILE *counts;
+        long written = 0, tokens = 0, rss, peak = 0;
+        double best = -1, seconds;
+        struct stat info;
+
+        snprintf(input, sizeof(input), "%s/%s.txt", directory, workloads[w]);
+        snprintf(command, sizeof(command), "'%s' %s %ld '%s'", generator, workloads[w], lines, input);
+        counts = popen(command, "r");
+        if (counts == NULL || fscanf(counts, "%ld %ld", &written, &tokens) != 2
+            || pclose(counts) != 0) {
+            fprintf(stderr, "harness: could not run %s\n", generator);
+            return 1;
+        }
+        if (stat(input, &info) != 0) {
+            perror("harness");
+            return 1;
+        }
+
+        args[options] = input;
+        args[options + 1] = "/dev/null";
+        args[options + 2] = NULL;
+        for (i = 0; i < runs; i++) {
+            seconds = run(args, &rss);
+            if (seconds < 0) {
+                best = -1;
+                break;
+            }
+            if (best < 0 || seconds < best) {
+                best = seconds;
+            }
+            if (rss > peak) {
+                peak = rss;
+            }
+        }
+
+        if (best < 0) {
+            printf("%-8s %8ld %10ld %8.1f %10s\n", workloads[w], written, tokens,
+                   info.st_size / 1048576.0, "failed");
+        } else {
+            printf("%-8s %8ld %10ld %8.1f %10.1f %12.0f %12.0f %6.1f MB\n", workloads[w],
+                   written, tokens, info.st_size / 1048576.0, best * 1e3,
+                   written / best, tokens / best, peak / 1024.0);
+        }
+        fflush(stdout);
+        unlink(input);
+    }
+    rmdir(directory);
+    return 0;
+}
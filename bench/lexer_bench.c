@@ -0,0 +1,202 @@
+/**
+ * lexer_bench.c - Tokens per second of get_token against the original
+ * strcmp/if-else tokenizer on a large generated input.
+ *
+ * Build: gcc -O2 -I.. -o lexer_bench lexer_bench.c ../Tokenizer.c ../Arena.c ../Scan.c ../Output.c
+ * Usage: lexer_bench [lines]
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+
+#define LEGACY_TSIZE 20
+#define LINE_SIZE 100 // room for the longest generated line
+
+static output_t diagnostics; // where lexical errors would be reported
+
+/* Operators used by the input generator */
+static const char *ops[] = {"+", "-", "*", "/", "^", "<", "<=", ">", ">=", "==", "!="};
+
+/* State of the original tokenizer, kept separate from tokenizer.c */
+static char *legacy_line;
+static int legacy_index;
+static char legacy_cat[OPSIZE];
+
+/**
+ * The original classify_token: an if/else chain over the current character,
+ * a memset of both buffers and a strcpy of the category name per token.
+ * @param token where the lexeme is copied to
+ */
+static void legacy_classify(char *token) {
+    char c = legacy_line[legacy_index];
+    char n = legacy_line[legacy_index + 1];
+    int length = 1;
+
+    memset(token, 0, LEGACY_TSIZE);
+    memset(legacy_cat, 0, OPSIZE);
+
+    if (c == '+') {
+        strcpy(legacy_cat, "ADD_OP");
+    } else if (c == '-') {
+        strcpy(legacy_cat, "SUB_OP");
+    } else if (c == '*') {
+        strcpy(legacy_cat, "MULT_OP");
+    } else if (c == '/') {
+        strcpy(legacy_cat, "DIV_OPP");
+    } else if (c == '(') {
+        strcpy(legacy_cat, "LEFT_PAREN");
+    } else if (c == ')') {
+        strcpy(legacy_cat, "RIGHT_PAREN");
+    } else if (c == '^') {
+        strcpy(legacy_cat, "EXPON_OP");
+    } else if (c == '<') {
+        length = n == '=' ? 2 : 1;
+        strcpy(legacy_cat, n == '=' ? "LESS_THEN_OR_EQUAL_OP" : "LESS_THEN_OP");
+    } else if (c == '>') {
+        length = n == '=' ? 2 : 1;
+        strcpy(legacy_cat, n == '=' ? "GREATER_THEN_OR_EQUAL_OP" : "GREATER_THEN_OP");
+    } else if (c == '=') {
+        length = n == '=' ? 2 : 1;
+        strcpy(legacy_cat, n == '=' ? "EQUALS_OP" : "NOT_A_TOKEN");
+    } else if (c == '!') {
+        length = n == '=' ? 2 : 1;
+        strcpy(legacy_cat, n == '=' ? "NOT_EQUALS_OP" : "NOT_A_TOKEN");
+    } else if (c == ';') {
+        strcpy(legacy_cat, "SEMI_COLON");
+    } else if (c == '0' || c == '1' || c == '2' || c == '3' || c == '4' ||
+               c == '5' || c == '6' || c == '7' || c == '8' || c == '9') {
+        token[0] = c;
+        while (length < LEGACY_TSIZE - 1 &&
+               (legacy_line[legacy_index + length] == '0' || legacy_line[legacy_index + length] == '1' ||
+                legacy_line[legacy_index + length] == '2' || legacy_line[legacy_index + length] == '3' ||
+                legacy_line[legacy_index + length] == '4' || legacy_line[legacy_index + length] == '5' ||
+                legacy_line[legacy_index + length] == '6' || legacy_line[legacy_index + length] == '7' ||
+                legacy_line[legacy_index + length] == '8' || legacy_line[legacy_index + length] == '9')) {
+            token[length] = legacy_line[legacy_index + length];
+            length++;
+        }
+        strcpy(legacy_cat, "INT_LITERAL");
+    } else {
+        strcpy(legacy_cat, "NOT_A_TOKEN");
+    }
+    memcpy(token, legacy_line + legacy_index, length);
+    legacy_index += length;
+}
+
+/**
+ * The original get_token: whitespace is skipped both before and after
+ * every token.
+ * @param token where the lexeme is copied to
+ * @return 0 at the end of the line, 1 otherwise
+ */
+static int legacy_get_token(char *token) {
+    while (legacy_line[legacy_index] == ' ' || legacy_line[legacy_index] == '\t' ||
+           legacy_line[legacy_index] == '\n' || legacy_line[legacy_index] == '\r') {
+        legacy_index++;
+    }
+    if (legacy_line[legacy_index] == '\0') {
+        return 0;
+    }
+    legacy_classify(token);
+    while (legacy_line[legacy_index] == ' ' || legacy_line[legacy_index] == '\t' ||
+           legacy_line[legacy_index] == '\n' || legacy_line[legacy_index] == '\r') {
+        legacy_index++;
+    }
+    return strcmp(legacy_cat, "NOT_A_TOKEN") != 0;
+}
+
+/**
+ * Fills buffer with count null terminated lines of random statements,
+ * generated from a fixed seed so every run sees the same input.
+ * @return an array of pointers to the start of each line
+ */
+static char **generate(int count, char **buffer) {
+    char **lines = malloc(count * sizeof(char *));
+    char *pos = *buffer = malloc((size_t) count * LINE_SIZE);
+    unsigned int seed = 12345;
+    int i;
+
+    for (i = 0; i < count; i++) {
+        int terms = 3 + i % 8;
+        int t;
+
+        lines[i] = pos;
+        for (t = 0; t < terms; t++) {
+            seed = seed * 1103515245 + 12345;
+            pos += sprintf(pos, "%s%u", t ? " " : "", (seed >> 8) % 100000);
+            if (t < terms - 1) {
+                pos += sprintf(pos, " %s", ops[(seed >> 20) % 11]);
+            }
+        }
+        pos += sprintf(pos, ";\n") + 1;
+    }
+    return lines;
+}
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    char *buffer;
+    char **lines = generate(count, &buffer);
+    char legacy_token[LEGACY_TSIZE];
+    context_t ctx;
+    token_t token;
+    long legacy_tokens = 0;
+    long tokens = 0;
+    double start, legacy_time, time;
+    int i;
+
+    output_fd(&diagnostics, 2);
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = &diagnostics;
+
+    start = now();
+    for (i = 0; i < count; i++) {
+        legacy_line = lines[i];
+        legacy_index = 0;
+        while (legacy_get_token(legacy_token)) {
+            legacy_tokens++;
+        }
+    }
+    legacy_time = now() - start;
+
+    start = now();
+    for (i = 0; i < count; i++) {
+        ctx.line = lines[i];
+        ctx.line_index = 0;
+        while (get_token(&ctx, &token)) {
+            tokens++;
+        }
+    }
+    time = now() - start;
+
+    if (tokens != legacy_tokens) {
+        fprintf(stderr, "token counts differ: %ld vs %ld\n", tokens, legacy_tokens);
+        return 1;
+    }
+    printf("%d lines, %ld tokens\n", count, tokens);
+    printf("legacy get_token: %8.3f s %12.0f tokens/s\n", legacy_time, legacy_tokens / legacy_time);
+    printf("table get_token:  %8.3f s %12.0f tokens/s\n", time, tokens / time);
+    printf("speedup:          %8.2fx\n", legacy_time / time);
+
+    free(lines);
+    free(buffer);
+    output_close(&diagnostics);
+    return 0;
+}
@@ -0,0 +1,204 @@
+/**
+ * load_client.c - Load test for interpreter -s. Opens a number of
+ * connections to the server, each on its own thread, and sends requests
+ * on each one, timing every request from sending its line to reading the
+ * empty line that ends its reply. With a window above 1, that many
+ * requests are kept in flight on each connection.
+ *
+ * Every request is a statement whose value is known, and its reply is
+ * checked, so a wrong answer is counted as well as a slow one. At the end
+ * it prints the throughput and the 50th, 99th and largest latencies.
+ *
+ * Build: gcc -O2 -o load_client load_client.c -lpthread
+ * Usage: load_client socket [connections] [requests per connection] [window]
+ *
+ * @version 10/17/2026
+ */
+
+#define _GNU_SOURCE // for memmem
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/* one connection and its share of the requests */
+typedef struct client {
+    pthread_t id;
+    int requests;
+    int window;
+    double *latencies;  // seconds each request took
+    int wrong;          // replies that were not the expected value
+} client_t;
+
+static struct sockaddr_un address;
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Writes the statement of a request and the reply it should get
+ * @param n the number of the request
+ * @param line set to the statement
+ * @param reply set to the reply
+ * @return the length of the statement
+ */
+static int request(int n, char *line, char *reply) {
+    int a = n % 1000, b = n % 7 + 1;
+
+    sprintf(reply, "Syntax OK\nValue is %d\n\n", (a + 3) * b - a / b);
+    return sprintf(line, "(%d + 3) * %d - %d / %d;\n", a, b, a, b);
+}
+
+/**
+ * Connects to the server, retrying for a while so it may still be starting
+ * @return the connection
+ */
+static int connect_server(void) {
+    int attempt;
+
+    for (attempt = 0; attempt < 100; attempt++) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (fd >= 0 && connect(fd, (struct sockaddr *) &address, sizeof(address)) == 0) {
+            return fd;
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+        usleep(20000);
+    }
+    fprintf(stderr, "ERROR: could not connect to %s\n", address.sun_path);
+    exit(1);
+}
+
+/**
+ * The body of a client thread: sends its requests and reads their replies
+ * @param arg the client
+ * @return NULL
+ */
+static void *run(void *arg) {
+    client_t *client = arg;
+    double *sent = malloc(client->requests * sizeof(double));
+    char buffer[65536], line[128], reply[128];
+    size_t used = 0;
+    int fd = connect_server();
+    int next = 0, done = 0;
+
+    if (sent == NULL) {
+        fprintf(stderr, "ERROR: out of memory\n");
+        exit(1);
+    }
+    while (done < client->requests) {
+        char *end;
+        ssize_t count;
+
+        //keep the window full
+        while (next < client->requests && next - done < client->window) {
+            int length = request(next, line, reply);
+
+            sent[next] = now();
+            if (write(fd, line, length) != length) {
+                fprintf(stderr, "ERROR: the server closed the connection\n");
+                exit(1);
+            }
+            next++;
+        }
+
+        count = read(fd, buffer + used, sizeof(buffer) - used);
+        if (count <= 0) {
+            fprintf(stderr, "ERROR: the server closed the connection\n");
+            exit(1);
+        }
+        used += count;
+
+        //every "\n\n" ends the reply of the oldest request in flight
+        while ((end = memmem(buffer, used, "\n\n", 2)) != NULL) {
+            size_t length = end + 2 - buffer;
+
+            client->latencies[done] = now() - sent[done];
+            request(done, line, reply);
+            if (length != strlen(reply) || memcmp(buffer, reply, length) != 0) {
+                client->wrong++;
+            }
+            memmove(buffer, buffer + length, used - length);
+            used -= length;
+            done++;
+        }
+    }
+    close(fd);
+    free(sent);
+    return NULL;
+}
+
+/**
+ * Orders latencies for qsort
+ */
+static int compare(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[]) {
+    int connections = argc > 2 ? atoi(argv[2]) : 4;
+    int requests = argc > 3 ? atoi(argv[3]) : 100000;
+    int window = argc > 4 ? atoi(argv[4]) : 1;
+    client_t *clients;
+    double *latencies;
+    double start, seconds;
+    long total;
+    int c, wrong = 0;
+
+    if (argc < 2 || connections < 1 || requests < 1 || window < 1
+        || strlen(argv[1]) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Usage: load_client socket [connections] [requests per connection] [window]\n");
+        return 1;
+    }
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, argv[1]);
+
+    total = (long) connections * requests;
+    clients = calloc(connections, sizeof(client_t));
+    latencies = malloc(total * sizeof(double));
+    if (clients == NULL || latencies == NULL) {
+        fprintf(stderr, "ERROR: out of memory\n");
+        return 1;
+    }
+
+    start = now();
+    for (c = 0; c < connections; c++) {
+        clients[c].requests = requests;
+        clients[c].window = window;
+        clients[c].latencies = latencies + (long) c * requests;
+        pthread_create(&clients[c].id, NULL, run, &clients[c]);
+    }
+    for (c = 0; c < connections; c++) {
+        pthread_join(clients[c].id, NULL);
+        wrong += clients[c].wrong;
+    }
+    seconds = now() - start;
+
+    qsort(latencies, total, sizeof(double), compare);
+    printf("%ld requests on %d connections, window %d, in %.2f s\n",
+           total, connections, window, seconds);
+    printf("  throughput: %12.0f requests/s\n", total / seconds);
+    printf("  p50:        %12.1f us\n", latencies[total / 2] * 1e6);
+    printf("  p99:        %12.1f us\n", latencies[total * 99 / 100] * 1e6);
+    printf("  max:        %12.1f us\n", latencies[total - 1] * 1e6);
+    printf("  wrong:      %12d\n", wrong);
+
+    free(latencies);
+    free(clients);
+    return wrong != 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * output_bench.c - Output bytes per second of per-statement fprintf against
+ * the buffered writer in output.c, copying and borrowing echoed lines.
+ *
+ * Every statement writes what main writes: the echoed line, then
+ * "Syntax OK\nValue is <n>\n".
+ *
+ * Build: gcc -O2 -I.. -o output_bench output_bench.c ../Output.c
+ * Usage: output_bench [statements] [outputFile] [longestLine]
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "Output.h"
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @return the size of a file, or 0 if it is not a regular file
+ */
+static double file_size(const char *path) {
+    struct stat info;
+    return stat(path, &info) == 0 ? (double) info.st_size : 0;
+}
+
+/**
+ * Writes every statement with the buffered writer.
+ */
+static void buffered(const char *path, char *text, size_t *starts, int *values, int count, int borrow) {
+    output_t output;
+    int i;
+
+    if (!output_open(&output, path)) {
+        fprintf(stderr, "ERROR: could not open %s for writing\n", path);
+        exit(1);
+    }
+    output.borrow = borrow;
+    for (i = 0; i < count; i++) {
+        output_echo(&output, text + starts[i], starts[i + 1] - starts[i]);
+        output_string(&output, "Syntax OK\nValue is ");
+        output_int(&output, values[i]);
+        output_string(&output, "\n");
+    }
+    output_close(&output);
+}
+
+int main(int argc, char *argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 2000000;
+    const char *path = argc > 2 ? argv[2] : "/dev/null";
+    int longest = argc > 3 ? atoi(argv[3]) : 250;
+    size_t *starts = malloc((count + 1) * sizeof(size_t));
+    int *values = malloc(count * sizeof(int));
+    char *text = malloc((size_t) count * (longest + 1) + 1);
+    char *pos = text;
+    unsigned int seed = 12345;
+    double start, elapsed[3], bytes = 0;
+    const char *names[] = {"fprintf per statement", "buffered, copied lines", "buffered, borrowed lines"};
+    FILE *file;
+    int i, way;
+
+    //lines of 20 to longest bytes with a value each
+    for (i = 0; i < count; i++) {
+        int length;
+
+        seed = seed * 1103515245 + 12345;
+        length = 20 + (seed >> 16) % (longest - 19);
+        starts[i] = pos - text;
+        memset(pos, '1', length - 2);
+        pos[length - 2] = ';';
+        pos[length - 1] = '\n';
+        pos += length;
+        values[i] = (int) (seed ^ (seed << 7));
+    }
+    starts[count] = pos - text;
+    *pos = '\0';
+
+    start = now();
+    file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "ERROR: could not open %s for writing\n", path);
+        return 1;
+    }
+    for (i = 0; i < count; i++) {
+        char saved = text[starts[i + 1]];
+
+        //fprintf("%s") needs the line to end in '\0'
+        text[starts[i + 1]] = '\0';
+        fprintf(file, "%s", text + starts[i]);
+        text[starts[i + 1]] = saved;
+        fprintf(file, "Syntax OK\nValue is %d\n", values[i]);
+    }
+    fclose(file);
+    elapsed[0] = now() - start;
+    bytes = file_size(path);
+
+    for (way = 0; way < 2; way++) {
+        start = now();
+        buffered(path, text, starts, values, count, way);
+        elapsed[way + 1] = now() - start;
+        if (bytes && file_size(path) != bytes) {
+            fprintf(stderr, "output sizes differ\n");
+            return 1;
+        }
+    }
+
+    if (!bytes) {
+        //count the bytes by hand when writing to a device
+        for (i = 0; i < count; i++) {
+            char number[16];
+            bytes += starts[i + 1] - starts[i] + 20 + sprintf(number, "%d", values[i]);
+        }
+    }
+
+    printf("%d statements, %.0f bytes\n", count, bytes);
+    for (way = 0; way < 3; way++) {
+        printf("%-25s %8.3f s %10.1f MB/s\n", names[way], elapsed[way], bytes / elapsed[way] / 1e6);
+    }
+
+    free(text);
+    free(values);
+    free(starts);
+    return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * result_bench.c - What it costs a program downstream to get the values
+ * of a run out of its text output and out of the result file -b wrote
+ * for the same input.
+ *
+ * The text is read whole into memory and every "Value is" line after a
+ * "Syntax OK" is parsed with strtoll; the result file is mapped with
+ * results_open and its records with RESULT_VALUE are read. Both ways sum
+ * the values, and the program stops if they do not find the same values.
+ * The time of each includes getting the file into memory, so both should
+ * be run from a warm page cache.
+ *
+ * Build: gcc -O2 -I.. -o result_bench result_bench.c ../Result.c ../Input.c ../Output.c
+ * Usage: result_bench textFile resultFile
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Output.h"
+#include "Input.h"
+#include "Result.h"
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Reads a whole file into memory, '\0' terminated
+ * @param path the file
+ * @param size set to its size
+ * @return its bytes, to be freed
+ */
+static char *read_file(const char *path, size_t *size) {
+    FILE *file = fopen(path, "rb");
+    char *data;
+
+    if (file == NULL || fseek(file, 0, SEEK_END) != 0) {
+        fprintf(stderr, "could not read %s\n", path);
+        exit(1);
+    }
+    *size = ftell(file);
+    rewind(file);
+    data = malloc(*size + 1);
+    if (data == NULL || fread(data, 1, *size, file) != *size) {
+        fprintf(stderr, "could not read %s\n", path);
+        exit(1);
+    }
+    data[*size] = '\0';
+    fclose(file);
+    return data;
+}
+
+/**
+ * The main function for the benchmark
+ * @param argc the argument count
+ * @param argv the argument list
+ * @return 0 if both ways found the same values
+ */
+int main(int argc, char *argv[]) {
+    static const char value_line[] = "Syntax OK\nValue is ";
+    result_file_t file;
+    char *text;
+    const char *pos;
+    size_t size;
+    long long text_sum = 0, record_sum = 0;
+    long text_count = 0, record_count = 0;
+    double start, text_time, record_time;
+    long i;
+
+    if (argc != 3) {
+        fprintf(stderr, "Usage: result_bench textFile resultFile\n");
+        return 1;
+    }
+
+    start = now();
+    text = read_file(argv[1], &size);
+    for (pos = strstr(text, value_line); pos != NULL; pos = strstr(pos, value_line)) {
+        char *end;
+
+        pos += sizeof(value_line) - 1;
+        text_sum += strtoll(pos, &end, 10);
+        text_count++;
+        pos = end;
+    }
+    text_time = now() - start;
+
+    start = now();
+    if (!results_open(&file, argv[2])) {
+        fprintf(stderr, "%s is not a result file\n", argv[2]);
+        return 1;
+    }
+    for (i = 0; i < file.count; i++) {
+        if (file.records[i].status == RESULT_VALUE) {
+            record_sum += file.records[i].value;
+            record_count++;
+        }
+    }
+    record_time = now() - start;
+
+    if (text_count != record_count || text_sum != record_sum) {
+        fprintf(stderr, "text has %ld values summing to %lld, records %ld summing to %lld\n",
+                text_count, text_sum, record_count, record_sum);
+        return 1;
+    }
+    printf("%ld values\n", record_count);
+    printf("  text:    %10zu bytes %8.2f ms %8.2f ns/value\n", size, text_time * 1e3,
+           text_time / (record_count ? record_count : 1) * 1e9);
+    printf("  records: %10zu bytes %8.2f ms %8.2f ns/value (%.1fx faster)\n", file.size,
+           record_time * 1e3, record_time / (record_count ? record_count : 1) * 1e9,
+           text_time / record_time);
+
+    results_close(&file);
+    free(text);
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * result_text.c - Writes the text output of a run again from the result
+ * file -b wrote and the input it was run on. The text is byte for byte
+ * what the run would have written without -b.
+ *
+ * Build: gcc -O2 -I.. -o result_text result_text.c ../Result.c ../Input.c ../Output.c
+ * Usage: result_text resultFile inputFile [outputFile]
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Output.h"
+#include "Input.h"
+#include "Result.h"
+
+/**
+ * The main function for the converter
+ * @param argc the argument count
+ * @param argv the argument list
+ * @return 0 if successful
+ */
+int main(int argc, char *argv[]) {
+    result_file_t file;
+    input_t input;
+    output_t output;
+
+    if (argc != 3 && argc != 4) {
+        fprintf(stderr, "Usage: result_text resultFile inputFile [outputFile]\n");
+        return 1;
+    }
+    if (!results_open(&file, argv[1])) {
+        fprintf(stderr, "ERROR: %s is not a result file\n", argv[1]);
+        return 1;
+    }
+    if (strcmp(argv[2], "-") == 0 ? !input_fd(&input, 0) : !input_open(&input, argv[2])) {
+        fprintf(stderr, "ERROR: could not open %s for reading\n", argv[2]);
+        return 1;
+    }
+    if (argc == 3 || strcmp(argv[3], "-") == 0) {
+        output_fd(&output, 1);
+    } else if (!output_open(&output, argv[3])) {
+        fprintf(stderr, "ERROR: could not open %s for writing\n", argv[3]);
+        return 1;
+    }
+    output.borrow = input.mapped;
+
+    results_write(&file, &input, &output);
+
+    output_close(&output);
+    input_close(&input);
+    results_close(&file);
+    return 0;
+}
@@ -0,0 +1,236 @@
+/**
+ * scan_bench.c - Tokens per second of get_token with each set of scan.c
+ * kernels, on digit-dense lines, on lines padded with long runs of
+ * whitespace, and on the short lines of lexer_bench for comparison. The
+ * scalar kernels go a byte at a time as the table did before them.
+ *
+ * Every kernel is first checked against the scalar one on runs of every
+ * length up to 100 at every alignment, and the tokens and values each one
+ * produces on the inputs must be the same.
+ *
+ * Build: gcc -O2 -I.. -o scan_bench scan_bench.c ../Tokenizer.c ../Arena.c ../Scan.c ../Output.c
+ * Usage: scan_bench [lines]
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Scan.h"
+
+#define LINE_SIZE 1024 // room for the longest generated line
+#define ROUNDS 5       // runs of each kernel, the fastest is reported
+
+static output_t diagnostics; // where lexical errors would be reported
+static unsigned int seed = 12345;
+
+/* the workloads, each line at most LINE_SIZE - 1 bytes */
+enum workload { DIGITS, SPACES, SHORT, WORKLOADS };
+static const char *workload_names[] = {"digits", "spaces", "short"};
+
+/* the sets of kernels, in the order they are tried */
+static const char *kernel_names[] = {"scalar", "sse2", "avx2"};
+
+/**
+ * @return the next number from 0 to bound - 1
+ */
+static unsigned next(unsigned bound) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % bound;
+}
+
+/**
+ * Writes one line of a workload
+ * @return the number of bytes written, without the '\0'
+ */
+static int generate_line(enum workload workload, char *pos) {
+    char *start = pos;
+    int terms = 3 + next(8);
+    int t, i;
+
+    for (t = 0; t < terms; t++) {
+        if (workload == DIGITS) {
+            //long literals, mostly past what an int holds
+            int digits = 8 + next(33);
+            for (i = 0; i < digits; i++) {
+                *pos++ = '0' + next(10);
+            }
+            *pos++ = t < terms - 1 ? "+-*<"[next(4)] : ';';
+        } else if (workload == SPACES) {
+            //a short literal in a wide column
+            int pad = 1 + next(64);
+            pos += sprintf(pos, "%u", next(1000));
+            for (i = 0; i < pad; i++) {
+                *pos++ = next(4) ? ' ' : '\t';
+            }
+            *pos++ = t < terms - 1 ? '+' : ';';
+            *pos++ = '\t';
+        } else {
+            pos += sprintf(pos, "%s%u", t ? " " : "", next(100000));
+            pos += sprintf(pos, t < terms - 1 ? " +" : ";");
+        }
+    }
+    *pos++ = '\n';
+    *pos = '\0';
+    return pos - start;
+}
+
+/**
+ * Fills a buffer with count lines of a workload, generated from a fixed
+ * seed so every run sees the same input
+ * @return an array of pointers to the start of each line
+ */
+static char **generate(enum workload workload, int count, char **buffer, long *bytes) {
+    char **lines = malloc(count * sizeof(char *));
+    char *pos = *buffer = malloc((size_t) count * LINE_SIZE);
+    int i;
+
+    if (lines == NULL || pos == NULL) {
+        fprintf(stderr, "ERROR: out of memory\n");
+        exit(1);
+    }
+    *bytes = 0;
+    for (i = 0; i < count; i++) {
+        int length = generate_line(workload, pos);
+
+        lines[i] = pos;
+        pos += length + 1;
+        *bytes += length;
+    }
+    return lines;
+}
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Checks the kernels in use against the scalar ones on runs of every
+ * length at every alignment, each followed by the end of a line
+ * @return 1 if they agree
+ */
+static int kernels_agree(const char *name) {
+    static char buffer[256] __attribute__((aligned(64)));
+    int offset, length, kind;
+
+    for (kind = 0; kind < 2; kind++) {
+        for (offset = 0; offset < 64; offset++) {
+            for (length = 1; length <= 100; length++) {
+                size_t (*kernel)(const char *);
+                size_t found;
+                int i;
+
+                memset(buffer, kind ? '7' : ' ', sizeof(buffer));
+                for (i = 0; i < length; i++) {
+                    buffer[offset + i] = kind ? '0' + i % 10 : " \t\r"[i % 3];
+                }
+                buffer[offset + length] = "\n\0+x"[length % 4];
+                kernel = kind ? scan.digits : scan.spaces;
+                found = kernel(buffer + offset);
+                if (found != (size_t) length) {
+                    fprintf(stderr, "%s: %s run of %d at offset %d measured %zu\n",
+                            name, kind ? "digit" : "space", length, offset, found);
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * Tokenizes every line and adds up the lengths, kinds and values of the
+ * tokens, so kernels that disagree anywhere give a different sum
+ * @return the sum, and tokens is set to the number of tokens
+ */
+static unsigned long tokenize(char **lines, int count, long *tokens) {
+    context_t ctx;
+    token_t token;
+    unsigned long sum = 0;
+    int i;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = &diagnostics;
+    *tokens = 0;
+    for (i = 0; i < count; i++) {
+        ctx.line = lines[i];
+        ctx.line_index = 0;
+        while (get_token(&ctx, &token)) {
+            sum = sum * 31 + token.kind * 1000 + token.length;
+            if (token.kind == INT_LITERAL) {
+                sum += (unsigned) int_value(&token);
+            }
+            (*tokens)++;
+        }
+    }
+    return sum;
+}
+
+int main(int argc, char *argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 200000;
+    int kernels = sizeof(kernel_names) / sizeof(kernel_names[0]);
+    int w, k, r;
+
+    output_fd(&diagnostics, 2);
+    for (k = 0; k < kernels; k++) {
+        if (scan_use(kernel_names[k]) && !kernels_agree(kernel_names[k])) {
+            return 1;
+        }
+    }
+
+    printf("%-8s %-8s %10s %10s %14s %10s\n", "input", "kernels", "MB", "best ms", "tokens/s", "speedup");
+    for (w = 0; w < WORKLOADS; w++) {
+        char *buffer;
+        long bytes;
+        char **lines = generate(w, count, &buffer, &bytes);
+        unsigned long expected = 0;
+        double scalar = 0;
+
+        for (k = 0; k < kernels; k++) {
+            double best = -1;
+            unsigned long sum;
+            long tokens;
+
+            if (!scan_use(kernel_names[k])) {
+                printf("%-8s %-8s not supported here\n", workload_names[w], kernel_names[k]);
+                continue;
+            }
+            for (r = 0; r < ROUNDS; r++) {
+                double start = now(), time;
+
+                sum = tokenize(lines, count, &tokens);
+                time = now() - start;
+                if (best < 0 || time < best) {
+                    best = time;
+                }
+            }
+            if (k == 0) {
+                expected = sum;
+                scalar = best;
+            } else if (sum != expected) {
+                fprintf(stderr, "%s: the %s kernels tokenize differently\n",
+                        workload_names[w], kernel_names[k]);
+                return 1;
+            }
+            printf("%-8s %-8s %10.1f %10.1f %14.0f %9.2fx\n", workload_names[w], kernel_names[k],
+                   bytes / 1048576.0, best * 1e3, tokens / best, scalar / best);
+        }
+        free(lines);
+        free(buffer);
+    }
+
+    scan_use(NULL);
+    output_close(&diagnostics);
+    return 0;
+}
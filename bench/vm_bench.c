@@ -0,0 +1,164 @@
+/**
+ * vm_bench.c - Expressions per second of the direct evaluating parser
+ * against the tree walker and the bytecode VM, on deep and wide expressions.
+ *
+ * The direct parser has to lex and parse the text on every evaluation, the
+ * other two parse once and only evaluate in the timed loop.
+ *
+ * Build: gcc -O2 -I.. -o vm_bench vm_bench.c ../Tokenizer.c ../Parser.c ../Symbols.c ../Ast.c ../Vm.c ../Arena.c ../Scan.c ../Output.c -lm
+ * Usage: vm_bench [iterations]
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Tokenizer.h"
+#include "Output.h"
+#include "Context.h"
+#include "Parser.h"
+#include "Ast.h"
+#include "Vm.h"
+
+static output_t diagnostics; // where syntax errors would be reported
+
+/**
+ * @return the current monotonic time in seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Builds a statement nested depth parentheses deep: ((1 + 1) * 1 - 1) ...
+ * @return the statement, to be freed by the caller
+ */
+static char *deep(int depth) {
+    static const char *ops[] = {" + ", " * ", " - ", " < ", " + ", " / "};
+    char *text = malloc(depth * 8 + 8);
+    char *pos = text;
+    int i;
+
+    for (i = 0; i < depth; i++) {
+        *pos++ = '(';
+    }
+    *pos++ = '7';
+    for (i = 0; i < depth; i++) {
+        pos += sprintf(pos, "%s%d)", ops[i % 6], 1 + i % 3);
+    }
+    strcpy(pos, ";");
+    return text;
+}
+
+/**
+ * Builds a flat statement of width terms: 3 * 4 + 5 ^ 2 - 6 ...
+ * @return the statement, to be freed by the caller
+ */
+static char *wide(int width) {
+    static const char *ops[] = {" + ", " * ", " - ", " ^ ", " >= ", " / ", " != "};
+    char *text = malloc(width * 12 + 8);
+    char *pos = text;
+    int i;
+
+    pos += sprintf(pos, "%d", 17);
+    for (i = 1; i < width; i++) {
+        const char *op = ops[i % 7];
+        pos += sprintf(pos, "%s%d", op, op[1] == '^' ? 1 + i % 2 : 1 + i % 97);
+    }
+    strcpy(pos, ";");
+    return text;
+}
+
+/**
+ * Times the three engines on one statement and prints the results
+ * @param name the name of the workload
+ * @param text the statement
+ * @param iterations how many times it is evaluated per engine
+ */
+static void run(const char *name, char *text, int iterations) {
+    context_t ctx;
+    token_t token;
+    ast_t ast;
+    program_t program;
+    int root;
+    int direct_value = 0, ast_value = 0, vm_value = 0;
+    double start, direct_time, ast_time, vm_time;
+    int i;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = &diagnostics;
+    ast_init(&ast);
+    program_init(&program);
+
+    start = now();
+    for (i = 0; i < iterations; i++) {
+        ctx.line = text;
+        ctx.line_index = 0;
+        get_token(&ctx, &token);
+        direct_value = bexpr(&ctx, &token);
+    }
+    direct_time = now() - start;
+
+    ctx.line = text;
+    ctx.line_index = 0;
+    get_token(&ctx, &token);
+    root = parse_bexpr(&ctx, &ast, &token);
+    if (root == NO_NODE) {
+        fprintf(stderr, "%s: does not parse\n", name);
+        exit(1);
+    }
+    compile(&program, &ast, root);
+
+    start = now();
+    for (i = 0; i < iterations; i++) {
+        ast_value = ast_eval(&ast, root);
+    }
+    ast_time = now() - start;
+
+    start = now();
+    for (i = 0; i < iterations; i++) {
+        vm_value = vm_run(&program);
+    }
+    vm_time = now() - start;
+
+    if (direct_value != ast_value || ast_value != vm_value) {
+        fprintf(stderr, "%s: values differ: %d %d %d\n", name, direct_value, ast_value, vm_value);
+        exit(1);
+    }
+
+    printf("%s (%d nodes, %d words of bytecode)\n", name, ast.count, program.count);
+    printf("  direct parser.c: %12.0f expressions/s\n", iterations / direct_time);
+    printf("  tree walk:       %12.0f expressions/s\n", iterations / ast_time);
+    printf("  bytecode vm:     %12.0f expressions/s (%.1fx direct)\n",
+           iterations / vm_time, direct_time / vm_time);
+
+    program_free(&program);
+    ast_free(&ast);
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+    char *text;
+
+    output_fd(&diagnostics, 2);
+
+    text = deep(500);
+    run("deep, 500 levels of parentheses", text, iterations);
+    free(text);
+
+    text = wide(1000);
+    run("wide, 1000 terms", text, iterations);
+    free(text);
+
+    text = wide(3);
+    run("short, 3 terms", text, iterations * 100);
+    free(text);
+
+    output_close(&diagnostics);
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * library_test.c - Runs statements through Library.h the way a program
+ * that embeds the interpreter would, and checks what comes back. make
+ * test builds and runs it.
+ *
+ * Build: cc -I.. -o library_test library_test.c <the objects of Library.c and what it uses>
+ * Usage: library_test
+ *
+ * @version 10/17/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Library.h"
+
+static int failures;
+
+/**
+ * Reports a check that did not hold
+ * @param ok 1 if it held
+ * @param what what was checked
+ */
+static void check(int ok, const char *what) {
+    if (!ok) {
+        printf("FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+/**
+ * @param depth how many parentheses to open
+ * @return "((...(1)...));" nested that deep, to be freed
+ */
+static char *nested(int depth) {
+    char *text = malloc(2 * (size_t) depth + 3);
+    int i;
+
+    if (text == NULL) {
+        fprintf(stderr, "ERROR: out of memory\n");
+        exit(1);
+    }
+    for (i = 0; i < depth; i++) {
+        text[i] = '(';
+        text[depth + 1 + i] = ')';
+    }
+    text[depth] = '1';
+    strcpy(text + 2 * depth + 1, ";");
+    return text;
+}
+
+/**
+ * The main function for the test
+ * @return 0 if every check held
+ */
+int main(void) {
+    enum engine engines[] = {DIRECT_ENGINE, AST_ENGINE, VM_ENGINE};
+    interp_result_t result;
+    char *deep = nested(300000);
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        interp_ctx_t *ctx = interp_create(engines[i]);
+
+        check(ctx != NULL, "interp_create");
+        check(interp_eval_string(ctx, "a = 6; a * 7;\n", &result) && result.value == 42
+              && result.statements == 2, "a = 6; a * 7;");
+
+        check(!interp_eval_string(ctx, "1/0; 5;", &result) && result.arithmetic_errors == 1
+              && result.statements == 1 && result.value == 5
+              && strstr(result.diagnostics, "division by zero") != NULL, "1/0; 5;");
+
+        //far deeper than the stack of a recursive parser goes
+        check(!interp_eval_string(ctx, deep, &result) && result.status == INTERP_OK
+              && result.errors == 1 && result.statements == 0
+              && strstr(result.diagnostics, "deeper than 10000 levels") != NULL,
+              "300000 parentheses past the default limit");
+
+        interp_max_depth(ctx, 300000);
+        check(interp_eval_string(ctx, deep, &result) && result.value == 1,
+              "300000 parentheses within interp_max_depth");
+
+        interp_max_depth(ctx, 3);
+        check(!interp_eval_string(ctx, "((((1))));", &result) && result.errors == 1
+              && strstr(result.diagnostics, "deeper than 3 levels") != NULL, "interp_max_depth(3)");
+
+        check(interp_eval_string(ctx, "a + 1;", &result) && result.value == 7,
+              "variables outlive an error");
+        interp_destroy(ctx);
+    }
+    free(deep);
+
+    if (failures > 0) {
+        return 1;
+    }
+    printf("tests/library_test passed with every engine\n");
+    return 0;
+}